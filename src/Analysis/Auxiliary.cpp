@@ -36,6 +36,8 @@ Auxiliary::Auxiliary(Setup *setup, FileIO *fileIO, Parallel *_parallel, Fields *
 
   FA_ZFProd      = new FileAttr("ZonalFlow", auxGroup, fileIO->file, 5, dim, mdim, cdim, moff, cdim, off, write, fileIO->complex_tid);
   FA_ZFProdTime  = fileIO->newTiming(auxGroup);
+
+  taskZF         = fileIO->scheduler->add("Aux.ZonalFlow", zonalFlow ? dataOutputZF : Timing(-1, -1.));
 }
 
 Auxiliary::~Auxiliary()
@@ -50,8 +52,8 @@ void Auxiliary::calculateZonalFlowProduction(const double dt)
 {
   const double _kw_12_dx = 1./(12.*dx);
 
-  [=](const CComplex fs [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-      const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+  [=](const PComplex fs [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+      const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
       const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
       CComplex      ZFProd[3][NsLD][Nky][NxLD],
       CComplex ZF_In[Nq][NzLD][Nky][NxLD], CComplex ZF_Out[Nq][NzLD][Nky][NxLD])
@@ -89,7 +91,7 @@ void Auxiliary::calculateZonalFlowProduction(const double dt)
       
   for(int v = NvLlD; v <= NvLuD; v++) {
                            
-    const CComplex f0_     = f0[s][m][z][y_k][x][v];
+    const double   f0_     = f0[s][m][z][x][v];
     const CComplex f1      = fs[s][m][z][y_k][x][v];
           
     const CComplex dfs_dx  = 8.*(fs[s][m][z][y_k][x+1][v] - fs[s][m][z][y_k][x-1][v])  
@@ -122,16 +124,18 @@ void Auxiliary::calculateZonalFlowProduction(const double dt)
   }
  
   } } // m, s
-  }( (A6zz) vlasov->f, (A6zz) vlasov->f0, (A6zz) fields->Field, (A4zz) ZFProd,
+  }( (A6pp) vlasov->f, (A5rr) vlasov->f0, (A6zz) fields->Field, (A4zz) ZFProd,
      (A4zz) ZF_Gyro_In, (A4zz) ZF_Gyro_Out);
 }
 
 void Auxiliary::writeData(const Timing &timing, const double dt)
 {
 
-  if (timing.check(dataOutputZF, dt)       )   {
+  if (taskZF->check(timing, dt)       )   {
 
   if(zonalFlow) {
+    Scheduler::Scope cost(taskZF);
+
     calculateZonalFlowProduction(dt); 
     
     parallel->reduce(ArrayZF.data(ZFProd), Op::sum, DIR_VM,  ArrayZF.getNum()); 
@@ -49,6 +49,7 @@ class Auxiliary
   bool zonalFlow; ///< calculate Zonal flow production rate
   
   Timing dataOutputZF; ///< Timing to output whole phase distribution function
+  Scheduler::Task *taskZF; ///< Scheduled output of zonal flow production
    
   hid_t auxGroup;
 
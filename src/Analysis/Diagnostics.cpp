@@ -13,6 +13,7 @@
 
 #include "Diagnostics.h"
 #include "Tools/System.h"
+#include "Tools/ScratchArena.h"
 
 Diagnostics::Diagnostics(Parallel *_parallel, Vlasov *_vlasov, Fields *_fields, Grid *_grid, Setup *_setup, FFTSolver *_fft, FileIO *fileIO, Geometry *_geo) : 
  
@@ -22,6 +23,11 @@ parallel(_parallel),setup(_setup), vlasov(_vlasov), grid(_grid), fields(_fields)
 
   initData(setup, fileIO);
 
+  // moments and fluxes are shared by all threads (not offset)
+  ArrayMom        = nct::allocate(nct::Range(0,8), nct::Range(0,NsLD), nct::Range(0,NzLD), nct::Range(0,Nky), nct::Range(0,NxLD)).purpose("Moments")(&Mom);
+  ArrayFlux       = nct::allocate(nct::Range(0,Nq), nct::Range(0,NsLD), nct::Range(0,Nky), nct::Range(0,NxLD)).purpose("Fluxes")(&HeatFlux, &PartFlux);
+  ArrayCrossPhase = nct::allocate(nct::Range(0,Nq), nct::Range(0,3), nct::Range(0,NsLD), nct::Range(0,Nky), nct::Range(0,NxLD)).purpose("Fluxes")(&CrossPhase);
+
   moments   = new Moments(setup, vlasov, fields, grid, parallel);
   auxiliary = new Auxiliary(setup, fileIO, parallel, fields, vlasov, grid, fft);
 }
@@ -31,6 +37,8 @@ Diagnostics::~Diagnostics()
   delete auxiliary;
   delete moments;
   closeData();
+
+  if(telemetry != nullptr) Telemetry::unmap(telemetry, telemetryName, true);
 }
 
 
@@ -92,57 +100,68 @@ void Diagnostics::getPowerSpectrum(CComplex  kXOut  [Nq][NzLD][Nky][FFTSolver::X
 
 //////////////////////// Calculate scalar values ///////////////////////////
 
-void Diagnostics::calculateScalarValues(const CComplex f [NsLD][NmLD][NzLB][Nky][NxLB][NvLB], 
-                                        const CComplex f0[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
+void Diagnostics::calculateScalarValues(const PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB], 
+                                        const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
                                         const CComplex Mom[8][NsLD][NzLD][Nky][NxLD], 
                                         const double   ParticleFlux[Nq][NsLD][Nky][NxLD], 
                                         const double   HeatFlux[Nq][NsLD][Nky][NxLD],
                                         ScalarValues &scalarValues) 
 
 {
+  #pragma omp single
+  {
+    scalarValues.kinetic_energy[0:Ns] = 0.;
+    scalarValues.entropy       [0:Ns] = 0.;
+  }
   
-  for(int s = NsGlD; s <= NsGuD; s++) {
-    
-      
-    double number        = 0.;
-    double kineticEnergy = 0.;
-    double entropy       = 0.;
-    double particle[Nq]; particle[:] = 0.;
-    double heat[Nq];         heat[:] = 0.;
-    
-    if((s >= NsLlD && s <= NsLuD)) {
-      
-    ////////////////////////////// Calculate Entropy /////////////////////////////////////
+  ////////////////////////////// Calculate Kinetic Energy & Entropy /////////////////////////////////////
 
-    // Kinetic energy is calculated in gyro-center coordinates
-    // Y.Idomura et al., J.Comp.Phys 2007, New conservative gk ..., Eq.(11)  [ but we use different normalization]
-    // Only y_k==0 has contributions, as other one cancel with integration over y
-    for(int m = NmLlD; m <= NmLuD; m++) {
+  // Kinetic energy is calculated in gyro-center coordinates
+  // Y.Idomura et al., J.Comp.Phys 2007, New conservative gk ..., Eq.(11)  [ but we use different normalization]
+  // Only y_k==0 has contributions, as other one cancel with integration over y
+  //
+  // Note : each thread sums over its part of (z,x), partial sums are added atomically
+  //        (reduction clause requires variables which are shared in enclosing parallel region)
+  for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) {
 
     const double d6Z = grid->dXYZ * dv * grid->dm[m] * pow2(species[s].m) * plasma->B0;
+    
+    double kineticEnergy = 0., entropy = 0.;
+
+    #pragma omp for collapse(2) nowait
     for(int z = NzLlD; z <= NzLuD; z++) { for(int x = NxLlD; x <= NxLuD; x++) { 
       
       kineticEnergy += creal(__sec_reduce_add((species[s].m * pow2(V[NvLlD:NvLD]) + M[m] * plasma->B0) * f[s][m][z][0][x][NvLlD:NvLD] * d6Z));
-    
-    } } // z, y_k, x
+      
+      entropy       += creal(pow2(__sec_reduce_add(f [s][m][z][0][x][NvLlD:NvLD])))/
+                                  __sec_reduce_add(f0[s][m][z][x][NvLlD:NvLD]);
+    } } // z, x
     
     // calculation through moments, (which one is correct ?)
     //    kineticEnergy = (species[s].m * __sec_reduce_add(creal(Mom[1][s-NsLlD][0:NzLD][0][0:NxLD])) +
     //                                    __sec_reduce_add(creal(Mom[2][s-NsLlD][0:NzLD][0][0:NxLD])) ) * grid->dXYZ;
     //kineticEnergy = (0.5 * species[s].m * __sec_reduce_add(creal(Mom[1][s-NsLlD][0:NzLD][0][0:NxLD])) +
     //                                      __sec_reduce_add(creal(Mom[2][s-NsLlD][0:NzLD][0][0:NxLD])) ) * grid->dXYZ;
-     
-    //#pragma omp parallel for reduction(+:entropy) collapse (2)
-    for(int z = NzLlD; z <= NzLuD; z++) { for(int x = NxLlD; x <= NxLuD; x++) { 
 
-      entropy += creal(pow2(__sec_reduce_add(f [s][m][z][0][x][NvLlD:NvLD])))/
-                            __sec_reduce_add(f0[s][m][z][0][x][NvLlD:NvLD]);
-    } } // z, y_k, x
+    #pragma omp atomic
+    scalarValues.kinetic_energy[s-1] += kineticEnergy;
+    #pragma omp atomic
+    scalarValues.entropy       [s-1] += entropy;
 
-    } // m 
+  } } // s, m 
+
+  #pragma omp barrier
+  
+  // remaining values are reductions over moments (small), communication is serialized
+  #pragma omp single
+  for(int s = NsGlD; s <= NsGuD; s++) {
+    
+    double number        = 0.;
+    double particle[Nq]; particle[:] = 0.;
+    double heat[Nq];         heat[:] = 0.;
     
     //// Calculate Total Heat & Particle Flux (reduction over moments variables (no v_par, no mu))
-    if (parallel->Coord[DIR_VM] == 0) { 
+    if((s >= NsLlD && s <= NsLuD) && (parallel->Coord[DIR_VM] == 0)) { 
    
       ////////////////////////////// Calculate Particle Number /////////////////////////////
       number =  creal(__sec_reduce_add(Mom[0][s-NsLlD][0:NzLD][0][0:NxLD]));
@@ -152,24 +171,18 @@ void Diagnostics::calculateScalarValues(const CComplex f [NsLD][NmLD][NzLB][Nky]
         heat    [q] = __sec_reduce_add(    HeatFlux[q][s-NsLlD][:][:]);
       } 
     }
-    
-    } // if(local s) 
 
     // Communicate with other groups (reduce whole structure)
     parallel->reduce(particle     , Op::sum, DIR_ALL, Nq);
     parallel->reduce(heat         , Op::sum, DIR_ALL, Nq);
-    kineticEnergy = parallel->reduce(kineticEnergy, Op::sum);
-    number        = parallel->reduce(number       , Op::sum);
+    number = parallel->reduce(number, Op::sum);
 
-    {
-       scalarValues.particle_number[s-1]  = number        ;
-       scalarValues.entropy        [s-1]  = entropy        ;
-       scalarValues.kinetic_energy [s-1]  = kineticEnergy;
-       scalarValues.particle_flux  [Nq*(s-1):Nq]  = particle[0:Nq];
-       scalarValues.heat_flux      [Nq*(s-1):Nq]  = heat[0:Nq] ;
-    }  
+    scalarValues.kinetic_energy[s-1]          = parallel->reduce(scalarValues.kinetic_energy[s-1], Op::sum);
+    scalarValues.particle_number[s-1]         = number;
+    scalarValues.particle_flux  [Nq*(s-1):Nq] = particle[0:Nq];
+    scalarValues.heat_flux      [Nq*(s-1):Nq] = heat[0:Nq] ;
 
-    } // s
+  } // s
 }
 
 void Diagnostics::getParticleHeatFlux( 
@@ -181,27 +194,30 @@ void Diagnostics::getParticleHeatFlux(
                                   )
 {
 
-  ParticleFlux[:][:][:][:]    = 0.;
-      HeatFlux[:][:][:][:]    = 0.;
-    CrossPhase[:][:][:][:][:] = 0.;
-
   // Triad condition. Heat/Particles are only transported by the y_k = 0, as the other y_k > 0 
   // modes cancels out. Thus multiplying y_k = 0 = A(y_k)*B(-y_k) = A(y_k)*[cc : B(y_k)]
   // where the complex conjugate values is used as physical value is a real quantity.
   
   // Note heat/particle fluxes are summed over z, cross-phases are averaged
+  //      threads are distributed over (y_k, x), thus each thread sums over z for its own points
   
-  if(parallel->Coord[DIR_V] == 0) { for(int s = NsLlD; s <= NsLuD; s++) {  
+  for(int s = NsLlD; s <= NsLuD; s++) {  
   
   double norm[3] = { 1., -species[s].v_th, species[s].T0 / (species[s].q * plasma->B0) };
 
   norm[:] *= species[s].n0 / geo->C;
   
+  #pragma omp for collapse(2)
+  for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { for(int x = NxLlD; x <= NxLuD; x++) { 
+
+    ParticleFlux[:][s-NsLlD][y_k][x-NxLlD]    = 0.;
+        HeatFlux[:][s-NsLlD][y_k][x-NxLlD]    = 0.;
+      CrossPhase[:][:][s-NsLlD][y_k][x-NxLlD] = 0.;
+  
+    if(parallel->Coord[DIR_V] != 0) continue;
+
   // Heat/Particle fluxes are calculates for each field quantity (phi, A_par, B_par)
-  for(int q = 0    ; q <  Nq   ; q++) {
- 
-  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
-  for(int x = NxLlD; x <= NxLuD; x++) { 
+  for(int q = 0    ; q <  Nq   ; q++) {  for(int z = NzLlD; z <= NzLuD; z++) { 
       
     // Do I have to include geometry terms ?! partial_y (phi, A_par, B_par)
     const CComplex iky_field  = -_imag * fft->ky(y_k) * Field0[q][z][y_k][x];
@@ -216,16 +232,18 @@ void Diagnostics::getParticleHeatFlux(
     CrossPhase[q][1][s-NsLlD][y_k][x-NxLlD] += carg( iky_field * conj(Mom[1][s-NsLlD][z-NzLlD][y_k][x-NxLlD])) / Nz;
     CrossPhase[q][2][s-NsLlD][y_k][x-NxLlD] += carg( iky_field * conj(Mom[2][s-NsLlD][z-NzLlD][y_k][x-NxLlD])) / Nz;
     
-  }    // x 
-  } }  // y_k, z
-  }    // q
+  } }  // q, z
+  } }  // y_k, x
 
-  } }  // s,v
+  }    // s
 
-  parallel->reduce(&ParticleFlux[0][0][0][0] , Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD);
-  parallel->reduce(&    HeatFlux[0][0][0][0] , Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD);
+  #pragma omp single
+  {
+    parallel->reduce(&ParticleFlux[0][0][0][0] , Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD);
+    parallel->reduce(&    HeatFlux[0][0][0][0] , Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD);
 
-  parallel->reduce(&CrossPhase[0][0][0][0][0], Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD * 3);
+    parallel->reduce(&CrossPhase[0][0][0][0][0], Op::sum, DIR_Z, Nq * NsLD * Nky * NxLD * 3);
+  }
 }
 
         
@@ -249,16 +267,16 @@ void Diagnostics::initData(Setup *setup, FileIO *fileIO)
      
   bool momWrite = (parallel->Coord[DIR_VM] == 0);
      
-  FA_Mom_00       = new FileAttr("Mom00"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
-  FA_Mom_20       = new FileAttr("Mom20"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
-  FA_Mom_02       = new FileAttr("Mom02"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
+  FA_Mom_00       = new FileAttr("Mom00"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
+  FA_Mom_20       = new FileAttr("Mom20"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
+  FA_Mom_02       = new FileAttr("Mom02"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
   
-  FA_Mom_10       = new FileAttr("Mom10"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
-  FA_Mom_30       = new FileAttr("Mom30"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
-  FA_Mom_12       = new FileAttr("Mom12"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid);
+  FA_Mom_10       = new FileAttr("Mom10"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
+  FA_Mom_30       = new FileAttr("Mom30"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
+  FA_Mom_12       = new FileAttr("Mom12"   , momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, fileIO->complex_tid, true, true);
 
-  FA_Mom_HeatFlux = new FileAttr("HeatFlux", momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite);
-  FA_Mom_PartFlux = new FileAttr("PartFlux", momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite);
+  FA_Mom_HeatFlux = new FileAttr("HeatFlux", momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, H5T_NATIVE_DOUBLE, true, true);
+  FA_Mom_PartFlux = new FileAttr("PartFlux", momGroup, fileIO->file, 5, mom_dsdim, mom_dmdim, mom_cDdim, mom_cmoff, mom_cBdim, mom_cdoff, momWrite, H5T_NATIVE_DOUBLE, true, true);
                                    
 
   FA_Mom_Time     = fileIO->newTiming(momGroup);
@@ -374,6 +392,39 @@ void Diagnostics::initData(Setup *setup, FileIO *fileIO)
   SVTable = new TableAttr(analysisGroup, "scalarValues", 12, SV_names, SV_cdoff, SV_types, SV_sizes, &scalarValues); 
 
   dataOutputStatistics  = Timing(setup->get("DataOutput.Statistics.Step", -1), setup->get("DataOutput.Statistics.Time", -1.));
+
+  // moments and fluxes are calculated once per time step for all outputs
+  productMoments = fileIO->scheduler->addProduct("Moments & Fluxes");
+  taskStatistics = fileIO->scheduler->add("Statistics", dataOutputStatistics, productMoments);
+  taskMoments    = fileIO->scheduler->add("Moments"   , dataOutputMoments   , productMoments);
+  taskXDep       = fileIO->scheduler->add("XDep"      , dataOutputXDep      , productMoments);
+
+  // monitor energy balance (e.g. for reduced precision runs)
+  checkConservation      = setup->get("Diagnostics.Conservation", 0);
+  haveConservationPrev   = false;
+  conservationPrev_t     = conservationPrev_E = conservationPrev_P = 0.;
+  conservationResidual_E = 0.;
+
+  // live telemetry of scalar values (segment is node-local, thus master process only)
+  static_assert(SPECIES_MAX <= Telemetry::MaxSpecies, "Telemetry::MaxSpecies too small");
+
+  telemetryName   = setup->get("DataOutput.Telemetry.Name", "");
+  telemetry       = nullptr;
+  telemetryRecord = Telemetry::Record();
+  scheduler       = fileIO->scheduler;
+
+  if((telemetryName != "") && (parallel->myRank == 0)) {
+
+    std::string names[Telemetry::MaxSpecies];
+    for(int s = 1; s <= Ns; s++) names[s-1] = species[s].name;
+
+    telemetry = Telemetry::create(telemetryName, std::max(1, setup->get("DataOutput.Telemetry.Records", 1024)), Ns, Nq, names);
+
+    if(telemetry == nullptr) parallel->print("Diagnostics : cannot create telemetry segment " + Telemetry::getSegmentName(telemetryName) + " (used by running simulation ?), disabled");
+  }
+
+  check(H5LTset_attribute_string(analysisGroup, ".", "PhasePrecision", 
+                                 sizeof(PComplex) == sizeof(CComplex) ? "double" : "single"), DMESG("H5LTset_attribute"));
 }
 
 void Diagnostics::getFieldEnergy(double& phiEnergy, double& ApEnergy, double& BpEnergy)
@@ -386,68 +437,86 @@ void Diagnostics::getFieldEnergy(double& phiEnergy, double& ApEnergy, double& Bp
 void Diagnostics::writeData(const Timing &timing, const double dt)
 
 {
+  // Note : called by all threads, calculations are distributed over the threads, 
+  //        while MPI communication and HDF-5 output is serialized (omp single)
 
-  if (timing.check(dataOutputMoments   , dt) || timing.check(dataOutputXDep, dt) ||
-      timing.check(dataOutputStatistics, dt)) 
+  const bool doMoments    = taskMoments   ->check(timing, dt),
+             doXDep       = taskXDep      ->check(timing, dt),
+             doStatistics = taskStatistics->check(timing, dt);
+
+  if (doMoments || doXDep || doStatistics) 
   {
 
-    CComplex  Mom[8][NsLD][NzLD][Nky][NxLD];
-        
-    double  HeatFlux[Nq]   [NsLD][Nky][NxLD],  // Heat     flux   
-            PartFlux[Nq]   [NsLD][Nky][NxLD],  // Particle flux
-          CrossPhase[Nq][3][NsLD][Nky][NxLD];  // Cross phases of fluxes
+    CComplex (*Mom_)[NsLD][NzLD][Nky][NxLD] = (CComplex (*)[NsLD][NzLD][Nky][NxLD]) Mom;
+
+    // Get Moments of Vlasov equation (shared by all outputs of this time step)
+    {
+      Scheduler::Scope cost(productMoments);
 
-    // Get Moments of Vlasov equation
-    moments->getMoments((A6zz) vlasov->f, (A4zz) fields->Field0, Mom);
+      moments->getMoments((A6pp) vlasov->f, (A4zz) fields->Field0, Mom_);
         
-    getParticleHeatFlux(PartFlux, HeatFlux, CrossPhase, (A4zz) fields->Field0, Mom);
+      getParticleHeatFlux((A4rr) PartFlux, (A4rr) HeatFlux, (A5rr) CrossPhase, (A4zz) fields->Field0, Mom_);
+    }
 
     ////////////////// Output Moments /////////////////////
 
-    if (timing.check(dataOutputMoments, dt) )   {
+    if (doMoments)   {
       
-      FA_Mom_HeatFlux->write((double *) &HeatFlux[0][0][0][0]);
-      FA_Mom_PartFlux->write((double *) &PartFlux[0][0][0][0]);
+      Scheduler::Scope cost(taskMoments);
+
+      #pragma omp single
+      {
+        FA_Mom_HeatFlux->write(HeatFlux);
+        FA_Mom_PartFlux->write(PartFlux);
 
-      FA_Mom_00->write((CComplex *) &Mom[0][0][0][0][0]);
-      FA_Mom_20->write((CComplex *) &Mom[1][0][0][0][0]);
-      FA_Mom_02->write((CComplex *) &Mom[2][0][0][0][0]);
+        FA_Mom_00->write((CComplex *) &Mom_[0][0][0][0][0]);
+        FA_Mom_20->write((CComplex *) &Mom_[1][0][0][0][0]);
+        FA_Mom_02->write((CComplex *) &Mom_[2][0][0][0][0]);
       
-      FA_Mom_10->write((CComplex *) &Mom[3][0][0][0][0]);
-      FA_Mom_30->write((CComplex *) &Mom[4][0][0][0][0]);
-      FA_Mom_12->write((CComplex *) &Mom[5][0][0][0][0]);
+        FA_Mom_10->write((CComplex *) &Mom_[3][0][0][0][0]);
+        FA_Mom_30->write((CComplex *) &Mom_[4][0][0][0][0]);
+        FA_Mom_12->write((CComplex *) &Mom_[5][0][0][0][0]);
       
-      FA_Mom_Time->write(&timing);
+        FA_Mom_Time->write(&timing);
 
-      parallel->print("Data I/O : Moments output");
+        parallel->print("Data I/O : Moments output");
+      }
     }
 
     ////////////////// Store X-dependent data /////////////
-    if (timing.check(dataOutputXDep, dt) )   {
+    if (doXDep)   {
 
-      FA_PartFluxKy->write((double *) PartFlux);
-      FA_HeatFluxKy->write((double *) HeatFlux);
-      FA_CrossPhase->write((double *) CrossPhase);
-      
-      double Mom_XDep[8][NsLD][NxLD]; 
+      Scheduler::Scope cost(taskXDep);
 
-      // Reduce moments over y_k and z
-      for(int n = 0    ; n <      8; n++) {
-      for(int s = NsLlD; s <= NsLuD; s++) {  for(int x = NxLlD; x <= NxLuD; x++) {
+      #pragma omp single
+      {
+        FA_PartFluxKy->write(PartFlux);
+        FA_HeatFluxKy->write(HeatFlux);
+        FA_CrossPhase->write(CrossPhase);
+      
+        double Mom_XDep[8][NsLD][NxLD]; 
+        
+        // Reduce moments over y_k and z
+        for(int n = 0    ; n <      8; n++) {
+        for(int s = NsLlD; s <= NsLuD; s++) {  for(int x = NxLlD; x <= NxLuD; x++) {
 
-        Mom_XDep[n][s-NsLlD][x-NxLlD] = __sec_reduce_add(creal(Mom[n][s-NsLlD][:][0][x-NxLlD]));
+          Mom_XDep[n][s-NsLlD][x-NxLlD] = __sec_reduce_add(creal(Mom_[n][s-NsLlD][:][0][x-NxLlD]));
 
-      } } }
+        } } }
    
-      FA_XDep_Mom ->write((double *) &Mom_XDep); 
-      FA_XDep_Time->write(&timing);
-
-      parallel->print("Data I/O : X-Dep output");
+        FA_XDep_Mom ->write((double *) &Mom_XDep); 
+        FA_XDep_Time->write(&timing);
 
+        parallel->print("Data I/O : X-Dep output");
+      }
     }  
 
     ////////////// Scalar Variables /////////////////
-    if (timing.check(dataOutputStatistics, dt) )   {
+    if (doStatistics)   {
+    
+    Scheduler::Scope cost(taskStatistics);
+
+    #pragma omp single
     { 
       // calculate mode spectrum of fields (phi, Ap, Bp)
 
@@ -459,26 +528,28 @@ void Diagnostics::writeData(const Timing &timing, const double dt)
       // Separately writing ? Hopefully it is buffered ... (passing stack pointer ... OK ?)
       FA_grow_x->write( &pSpecX [0][0]); FA_grow_y->write(&pSpecY [0][0]); FA_grow_t->write(&timing);
       FA_freq_x->write( &pPhaseX[0][0]); FA_freq_y->write(&pPhaseY[0][0]); FA_freq_t->write(&timing);
-    }
-
-    ScalarValues scalarValues;
-   
-
-    static struct timeval walltime = System::getTimeOfDay();  
+    
+      static struct timeval walltime = System::getTimeOfDay();  
 
-    // Need to communicate wall clock time to other processes (as HDF-5 table requires same value)
-    scalarValues.walltime = parallel->bcast(System::getTimeDifference(walltime), parallel->myRank == 0) ;
-    scalarValues.timestep = timing.step;
-    scalarValues.time     = timing.time;
-    scalarValues.dt       = dt;
+      // Need to communicate wall clock time to other processes (as HDF-5 table requires same value)
+      scalarValues.walltime = parallel->bcast(System::getTimeDifference(walltime), parallel->myRank == 0) ;
+      scalarValues.timestep = timing.step;
+      scalarValues.time     = timing.time;
+      scalarValues.dt       = dt;
     
-    fields->getFieldEnergy(scalarValues.phiEnergy, scalarValues.ApEnergy, scalarValues.BpEnergy);
+      fields->getFieldEnergy(scalarValues.phiEnergy, scalarValues.ApEnergy, scalarValues.BpEnergy);
+    }
     
-    //  Get scalar values for every species ( this is bad, should calculate them all together)
-    calculateScalarValues((A6zz) vlasov->f, (A6zz) vlasov->f0,
-                           Mom, PartFlux, HeatFlux, scalarValues); 
+    //  Get scalar values for every species 
+    calculateScalarValues((A6pp) vlasov->f, (A5rr) vlasov->f0,
+                          Mom_, (A4rr) PartFlux, (A4rr) HeatFlux, scalarValues); 
+
+    #pragma omp single
+    {
 
     SVTable->append(&scalarValues);
+
+    if(telemetry != nullptr) publishTelemetry();
     
     ////////////////// print out some statistics /////////////////////////////
     
@@ -523,13 +594,50 @@ void Diagnostics::writeData(const Timing &timing, const double dt)
     if(Ns > 1) messageStream << "    Total Charge = " << ((species[0].n0 != 0.) ? 0. : total_charge);
     messageStream << std::endl; 
 
+    if(checkConservation) {
+
+      const double total_energy = kinetic_energy + scalarValues.phiEnergy + scalarValues.ApEnergy + scalarValues.BpEnergy;
+
+      // power of gradient drive (fluxes summed over fields)
+      double power = 0.;
+      for(int s = NsGlD; s <= NsGuD; s++) {
+
+        power += species[s].T0 * (species[s].w_n * __sec_reduce_add(scalarValues.particle_flux[Nq*(s-1):Nq])
+                                + species[s].w_T * __sec_reduce_add(scalarValues.heat_flux    [Nq*(s-1):Nq]));
+      }
+
+      // residual of energy balance since previous output
+      if(haveConservationPrev && (scalarValues.time > conservationPrev_t)) {
+
+        const double dE_dt    = (total_energy - conservationPrev_E) / (scalarValues.time - conservationPrev_t);
+        const double P_mean   = 0.5 * (power + conservationPrev_P);
+        const double residual = std::abs(dE_dt - P_mean) / ((P_mean == 0.) ? 1. : std::abs(P_mean));
+
+        conservationResidual_E = std::max(conservationResidual_E, residual);
+
+        messageStream << "         | Energy balance (" << (sizeof(PComplex) == sizeof(CComplex) ? "double" : "single")
+                      << ") : dE/dt = " << dE_dt << " P = " << P_mean << std::noshowpos 
+                      << " |dE/dt - P|/P = " << residual << "  (max " << conservationResidual_E << ")" << std::endl;
+      }
+
+      conservationPrev_t   = scalarValues.time;
+      conservationPrev_E   = total_energy;
+      conservationPrev_P   = power;
+      haveConservationPrev = true;
+    }
+
     parallel->print(messageStream.str());
+
+    } // omp single
     
    }
   
   }
 
+  // Note : not parallelized (yet), thus executed by master thread only
+  #pragma omp master
   auxiliary->writeData(timing, dt);
+  #pragma omp barrier
 
 }
 
@@ -559,8 +667,45 @@ void Diagnostics::setMPIStruct()
 
 }
 
+void Diagnostics::publishTelemetry()
+{
+  Telemetry::Record &r = telemetryRecord;
+
+  // mean wall time per time step since previous record
+  r.stepTime  = (scalarValues.timestep > r.timestep) ? (scalarValues.walltime - r.walltime) / (scalarValues.timestep - r.timestep) : 0.;
+
+  r.timestep  = scalarValues.timestep;
+  r.walltime  = scalarValues.walltime;
+  r.time      = scalarValues.time;
+  r.dt        = scalarValues.dt;
+  r.phiEnergy = scalarValues.phiEnergy;
+  r.ApEnergy  = scalarValues.ApEnergy;
+  r.BpEnergy  = scalarValues.BpEnergy;
+
+  r.particle_number[0:Ns]    = scalarValues.particle_number[0:Ns];
+  r.kinetic_energy [0:Ns]    = scalarValues.kinetic_energy [0:Ns];
+  r.entropy        [0:Ns]    = scalarValues.entropy        [0:Ns];
+  r.heat_flux      [0:Ns*Nq] = scalarValues.heat_flux      [0:Ns*Nq];
+  r.particle_flux  [0:Ns*Nq] = scalarValues.particle_flux  [0:Ns*Nq];
+
+  // cost of scheduled diagnostics (in order of registration)
+  r.numStages = 0;
+  for(auto &task : scheduler->getTasks()) {
+
+    if(r.numStages == Telemetry::MaxStages) break;
+
+    Telemetry::Stage &stage = r.stage[r.numStages++];
+    std::strncpy(stage.name, task.name.c_str(), sizeof(stage.name) - 1);
+    stage.cost = task.cost;
+  }
+
+  Telemetry::publish(telemetry, r);
+}
+
 void Diagnostics::closeData() 
 {
+  // writes buffered scalar values
+  delete SVTable;
 
   delete FA_HeatFluxKy; 
   delete FA_PartFluxKy;
@@ -577,7 +722,10 @@ void Diagnostics::closeData()
   delete FA_Mom_HeatFlux; delete FA_Mom_PartFlux;
   delete FA_Mom_Time;
 
-  delete SVTable;
+  if(checkConservation) {
+
+    check(H5LTset_attribute_double(analysisGroup, ".", "EnergyBalanceResidual", &conservationResidual_E, 1), DMESG("H5LTset_attribute"));
+  }
 
   H5Gclose(analysisGroup);
 
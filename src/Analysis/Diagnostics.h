@@ -26,6 +26,7 @@
 #include "Plasma.h"
 #include "Analysis/Moments.h"
 #include "Analysis/Auxiliary.h"
+#include "Tools/Telemetry.h"
 
 /**
 *    @brief Data diagnostics and output
@@ -71,6 +72,15 @@ class Diagnostics : public IfaceGKC {
     double particle_flux  [SPECIES_MAX*3]; ///< Total particle flux (per species) for \f$ (\phi,A_\parallel, B_\parallel) \f$
 
   } ScalarValues;
+
+  ScalarValues scalarValues; ///< Scalar values of current output (shared by threads)
+
+  CComplex *Mom;            ///< Moments [8][NsLD][NzLD][Nky][NxLD] (not offset, shared by threads)
+  double   *HeatFlux,       ///< Heat flux [Nq][NsLD][Nky][NxLD] (not offset)
+           *PartFlux,       ///< Particle flux [Nq][NsLD][Nky][NxLD] (not offset)
+           *CrossPhase;     ///< Cross phases of fluxes [Nq][3][NsLD][Nky][NxLD] (not offset)
+
+  nct::allocate ArrayMom, ArrayFlux, ArrayCrossPhase;
    
   //////////////  Data Output Stuff //////////////////
    
@@ -78,6 +88,11 @@ class Diagnostics : public IfaceGKC {
          dataOutputMoments   , ///< Timing to define output of moments
          dataOutputXDep      ; ///< Timing to define output of X-dependent variables
 
+  Scheduler::Task *taskStatistics, ///< Scheduled output of scalarValues
+                  *taskMoments   , ///< Scheduled output of moments
+                  *taskXDep      , ///< Scheduled output of X-dependent variables
+                  *productMoments; ///< Moments & fluxes (shared by above outputs)
+
   ///@{
   ///@ingroup HDF-5 Attributes 
   FileAttr *FA_Mom_00      ,  ///< Density  
@@ -110,6 +125,54 @@ class Diagnostics : public IfaceGKC {
 
   ///@}
 
+  /**
+  *   @brief Energy balance check (Diagnostics.Conservation)
+  *
+  *   In gradient-driven turbulence the total energy E (kinetic + field) is
+  *   not conserved, but changes by the power of the gradient drive
+  *
+  *   \f[
+  *       P = \sum_\sigma T_{0\sigma} \left( \omega_n \Gamma_\sigma + \omega_T Q_\sigma \right)
+  *   \f]
+  *
+  *   thus between consecutive statistics outputs the residual
+  *   \f$ R = \Delta E / \Delta t - \bar{P} \f$ (P averaged by the trapezoidal
+  *   rule) is reported relative to \f$ \bar{P} \f$. It contains the
+  *   dissipation (collisions, hyperviscosity) and time discretization error,
+  *   which are the same for single (GKC_PHASE_SINGLE) and double precision
+  *   phase-space storage of a case, thus a larger residual in single precision
+  *   shows the error of the reduced storage precision.
+  *
+  **/
+  bool   checkConservation;          ///< true if energy balance is monitored
+  bool   haveConservationPrev;       ///< true if values of previous output are set
+  double conservationPrev_t,         ///< time of previous output
+         conservationPrev_E,         ///< total energy (kinetic + field) of previous output
+         conservationPrev_P,         ///< power of gradient drive of previous output
+         conservationResidual_E;     ///< maximum relative residual of energy balance
+
+  /**
+  *   @brief Live telemetry of scalar values (DataOutput.Telemetry.Name)
+  *
+  *   If a name is given, the master process publishes each output of the
+  *   scalar values, together with the cost of the scheduled diagnostics,
+  *   into the shared-memory ring buffer /<name> of DataOutput.Telemetry.Records
+  *   records (see Telemetry). It can be read during the run by gkc-telemetry.
+  *   Only the cost of diagnostics is published per stage, the time integration
+  *   enters as mean wall time per time step.
+  *
+  **/
+  Telemetry::Header *telemetry;       ///< ring buffer (nullptr if disabled)
+  std::string        telemetryName;   ///< name of shared-memory segment
+  Telemetry::Record  telemetryRecord; ///< last published record
+  Scheduler         *scheduler;       ///< scheduled diagnostics (for their cost)
+
+  /**
+  *   @brief publish current scalar values to telemetry ring buffer
+  *
+  **/
+  void publishTelemetry();
+
   //////////////////////////////////////////////////////////////
   Parallel *parallel;
   Setup *setup;
@@ -185,12 +248,15 @@ class Diagnostics : public IfaceGKC {
   *
   *  Calculate entropy using Imadera et al.
   *
+  *  Has to be called by all threads, kinetic energy and entropy are summed
+  *  over (z,x) in parallel, scalarValues has to be shared.
+  *
   *  @param species particle species \f$ \sigma \f$
   *  @return   the total energy of species
   *
   **/
-  void calculateScalarValues(const CComplex f [NsLD][NmLD][NzLB][NkyLD][NxLB][NvLB], 
-                             const CComplex f0[NsLD][NmLD][NzLB][NkyLD][NxLB][NvLB],
+  void calculateScalarValues(const PComplex f [NsLD][NmLB][NzLB][NkyLD][NxLB][NvLB], 
+                             const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
                              const CComplex Mom[8][NsLD][NzLD][NkyLD][NxLD], 
                              const double ParticleFlux[Nq][NsLD][NkyLD][NxLD], 
                              const double HeatFlux[Nq][NsLD][NkyLD][NxLD],
@@ -218,6 +284,8 @@ class Diagnostics : public IfaceGKC {
   *                \right> 
   *  \f]
   *
+  *  Has to be called by all threads, which are distributed over \f$ (k_y, x) \f$.
+  *
   *  @todo include FLR correction terms
   *        include Geometry factors
   * 
@@ -247,6 +315,15 @@ class Diagnostics : public IfaceGKC {
   //////////////////////////////////  Data-I/0 stuff ////////////////////////////////////////
 
   void initData(Setup *setup, FileIO *fileIO) ;
+
+  /**
+  *   @brief calculate diagnostics and write output
+  *
+  *   Has to be called by all threads of the parallel region (or outside of 
+  *   any). The calculation is distributed over the threads, while MPI 
+  *   communication and HDF-5 output is serialized.
+  *
+  **/
   void writeData(const Timing &timing, const double dt);
   void closeData();
       
@@ -12,6 +12,11 @@
  */
 
 #include "Analysis/Moments.h"
+#include "Tools/ScratchArena.h"
+
+// powers (a,b) of v_\parallel^a \mu^{b/2} for Mom[n] (in order of output)
+static const int mom_a[8] = { 0, 2, 0, 1, 3, 1, 2, 0 },
+                 mom_b[8] = { 0, 0, 2, 0, 0, 2, 2, 4 };
   
   
 Moments::Moments(Setup *setup, Vlasov *_vlasov, Fields *_fields, Grid *_grid, Parallel *_parallel) 
@@ -20,99 +25,102 @@ Moments::Moments(Setup *setup, Vlasov *_vlasov, Fields *_fields, Grid *_grid, Pa
 
   doFieldCorrections = setup->get("Moments.FieldCorrections", 1);
 
-}
+  ArrayWeights = nct::allocate(grid->RsLD, nct::Range(0,8), grid->RmLD, grid->RvLD)(&w_ab);
+  ArrayMom_m   = nct::allocate(grid->RmLD, nct::Range(0,8), grid->RsLD, grid->RzLD, grid->RkyLD, grid->RxLD).purpose("Moments")(&Mom_m);
 
-void Moments::getMoments(const CComplex     f    [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                         const CComplex Field0[Nq][NzLD][Nky][NxLD],
-                               CComplex Mom[8][NsLD][NzLD][Nky][NxLD]) 
-{
+  // pre-calculate weights including normalization (instead of pow(...) for each point)
+  [=](double w[NsLD][8][NmLD][NvLD])
+  {
+    const double rho_L_ref = plasma->rho_ref / plasma->L_ref; 
 
-  getMoment(f, Field0, Mom, 0, 0, 0); 
-  getMoment(f, Field0, Mom, 2, 0, 1); 
-  getMoment(f, Field0, Mom, 0, 2, 2); 
+    for(int s = NsLlD; s <= NsLuD; s++) { for(int n = 0; n < 8; n++) { 
+      
+      const int    a     = mom_a[n], b = mom_b[n];
+      const double d_pre = rho_L_ref * plasma->n_ref * species[s].n0 * pow(plasma->c_ref * species[s].v_th, a+b);
+      
+      for(int m = NmLlD; m <= NmLuD; m++) {
 
-  getMoment(f, Field0, Mom, 1, 0, 3); 
-  getMoment(f, Field0, Mom, 3, 0, 4); 
-  getMoment(f, Field0, Mom, 1, 2, 5); 
-  
-  getMoment(f, Field0, Mom, 2, 2, 6); 
-  getMoment(f, Field0, Mom, 0, 4, 7); 
+        const double d_DK = d_pre * M_PI * dv * grid->dm[m] * pow(plasma->B0, b/2);
 
+        w[s][n][m][NvLlD:NvLD] = d_DK * pow(M[m], b/2.) * pow(V[NvLlD:NvLD], a);
+      }
+    } } // s, n
+  } ((A4rr) w_ab);
 }
 
-void Moments::getMoment(const CComplex     f    [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                        const CComplex  Field0[Nq][NzLD][Nky][NxLD],
-                        CComplex Mom[8][NsLD][NzLD][Nky][NxLD], const int a, const int b, const int idx)
+void Moments::getMoments(const PComplex     f    [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                         const CComplex Field0[Nq][NzLD][Nky][NxLD],
+                               CComplex Mom[8][NsLD][NzLD][Nky][NxLD]) 
 {
-  Mom[idx][:][:][:][:] = 0.;
- 
-  // temporary arrays for integration over \mu
-  // Need Nq in order to let gyro-averaging work for Nq > 1
-  CComplex Mom_m[Nq][NzLD][Nky][NxLD];
-  
-  // We have set to zero, because gyro-averaging operator currently requires size [Nq][...].
-  // and surplus arrays may contain NaN
-  if(Nq > 1) Mom_m[1:Nq-1][:][:][:] = 0.;
-
-  for(int s = NsLlD; s <= NsLuD; s++) {
+  [=](const PComplex f    [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
+      const double   w    [NsLD][8][NmLD][NvLD],
+            CComplex Mom_m[NmLD][8][NsLD][NzLD][Nky][NxLD])
+  {
+    // calculate drift-kinetic moments (in gyro-coordinates), all moments in single pass over f
+    #pragma omp for collapse(3)
+    for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) { for(int z = NzLlD; z <= NzLuD; z++) { 
     
-  // Scaling terms (1) 
-  const double rho_L_ref = plasma->rho_ref / plasma->L_ref; 
-  const double d_pre     = rho_L_ref * plasma->n_ref * species[s].n0 * pow(plasma->c_ref * species[s].v_th, a+b);
-  
-  // integrate over the first adiabatic invariant \mu
-  for(int m = NmLlD; m <= NmLuD; m++) {
-  
-  const double d_DK = d_pre * M_PI * dv * grid->dm[m] * pow(plasma->B0, b/2);
-  
-  // calculate drift-kinetic moments (in gyro-coordinates) 
-  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = 0; y_k < Nky-1; y_k++) { 
-  for(int x = NxLlD; x <= NxLuD; x++) { 
-     
-    Mom_m[0][z-NzLlD][y_k][x-NxLlD] = __sec_reduce_add(pow(M[m], b/2.) * pow(V[NvLlD:NvLD],a) 
-                                                       * f[s][m][z][y_k][x][NvLlD:NvLD]);
-  } } } // z, y_k, x
-  
-    // gyro-average moments (push back to drift-coordinates)
-    #pragma omp parallel
-    fields->gyroAverage(Mom_m, Mom_m, m, s, false, true);
+    for(int y_k = 0; y_k < Nky; y_k++) { for(int x = NxLlD; x <= NxLuD; x++) { 
 
-    Mom[idx][s-NsLlD][:][:][:] += Mom_m[0][:][:][:] * d_DK;
+      // Nyquist mode is not evolved
+      for(int n = 0; n < 8; n++) {
 
-  } // m
+        Mom_m[m][n][s][z][y_k][x] = (y_k < Nky-1) ? __sec_reduce_add(w[s][n][m][NvLlD:NvLD] * f[s][m][z][y_k][x][NvLlD:NvLD]) : 0.;
+      }
+    } } // y_k, x
+    
+    } } } // s, m, z
 
-  // all operators are linear in v,m thus we sum here 
-  parallel->reduce(&Mom[idx][s-NsLlD][0][0][0], Op::sum, DIR_VM, NzLD * Nky * NxLD); 
+  } ((A6pp) f, (A4rr) w_ab, (A6zz) Mom_m);
+  
+  // gyro-average moments (push back to drift-coordinates) and sum over \mu
+  fields->gyroAverageMoments((A6zz) ArrayMom_m.data(Mom_m), Mom);
 
+  // all operators are linear in v,m thus we sum here 
+  #pragma omp single
+  parallel->reduce(&Mom[0][0][0][0][0], Op::sum, DIR_VM, 8 * NsLD * NzLD * Nky * NxLD); 
 
   //////////////////////////////////////////////////////////////////////////
-  // add field corrections (necessary for k_perp^2 > 1)
+  // add field corrections (necessary for k_perp^2 > 1), cheap compared to
+  // the integration over f, thus calculated by a single thread
+  #pragma omp single
   if(doFieldCorrections) {
  
-    // pre-factors for field corrections (note : x-dependence of T neglected)
-    const double d_FC = d_pre;// * species[s].n0/species[s].T0;
-    
-    double bT_q_B2vth = plasma->beta * species[s].T0/pow2(plasma->B0) 
-                        / (species[s].q  * species[s].v_th);
+    ScratchArena::Frame frame_FC;
 
-    CComplex AAphi[Nq][NzLD][Nky][NxLD],  phi0[Nq][NzLD][Nky][NxLD],
-             j0_par[NzLD][Nky][NxLD];
+    CComplex (*AAphi )[Nq][NzLD][Nky][NxLD] = (CComplex (*)[Nq][NzLD][Nky][NxLD]) ScratchArena::get<CComplex>(3 * Nq * NzLD * Nky * NxLD);
+    CComplex (*phi0  )    [NzLD][Nky][NxLD] = (CComplex (*)    [NzLD][Nky][NxLD]) ScratchArena::get<CComplex>(    Nq * NzLD * Nky * NxLD),
+             (*j0_par)          [Nky][NxLD] = (CComplex (*)          [Nky][NxLD]) ScratchArena::get<CComplex>(         NzLD * Nky * NxLD);
 
     phi0[0][:][:][:] = Field0[Field::phi][NzLlD:NzLD][:][NxLlD:NxLD];
 
     // The equilibrium current forms the equilibrium magnetic field.
     // As this current is stationary and handles the background magnetic field,
     // we can set it to zero. D. Told (PhD thesis, p.31) has some discussions about it.
-    j0_par[:][:][:] = 0.;
+    j0_par[0:NzLD][:][:] = 0.;
+    
+    const double rho_L_ref = plasma->rho_ref / plasma->L_ref; 
+
+    for(int s = NsLlD; s <= NsLuD; s++) {
+    
+      double bT_q_B2vth = plasma->beta * species[s].T0/pow2(plasma->B0) 
+                          / (species[s].q  * species[s].v_th);
 
-    // calculate double gyro-average 
-    fields->doubleGyroExp(phi0, AAphi, b/2, s);
+      // calculate double gyro-average (depends only on b/2, thus shared between moments)
+      for(int k = 0; k <= 2; k++) fields->doubleGyroExp(phi0, AAphi[k], k, s);
+      
+      for(int n = 0; n < 8; n++) {
+
+        const int a = mom_a[n], b = mom_b[n];
+
+        // pre-factors for field corrections (note : x-dependence of T neglected)
+        const double d_FC = rho_L_ref * plasma->n_ref * species[s].n0 * pow(plasma->c_ref * species[s].v_th, a+b);
     
-    // add field corrections from gyro-kinetic effects 
-    Mom[idx][s-NsLlD][:][:][:] -= d_FC * (Y(a) + Y(a+1) * bT_q_B2vth * j0_par[:][:][:]) *
-                          (species[s].q * (phi0[0][:][:][:] -  AAphi[0][:][:][:]));
+        // add field corrections from gyro-kinetic effects 
+        Mom[n][s-NsLlD][:][:][:] -= d_FC * (Y(a) + Y(a+1) * bT_q_B2vth * j0_par[0:NzLD][:][:]) *
+                                    (species[s].q * (phi0[0][:][:][:] -  AAphi[b/2][0][:][:][:]));
+      } // n
+    } // s
 
   } // doFieldCorrections
-  } // s
 }
-
@@ -93,6 +93,20 @@ class Moments
    
   bool doFieldCorrections; ///< Include gyro-kinetic field corrections
 
+  /**
+  *   @brief integration weights of the moments
+  *
+  *   Pre-calculated as w_ab[s][n][m][v] including the normalization 
+  *   and integration weights for moment n with powers (a,b), thus
+  *   \f$ M_{ab} = \sum_{v} w_{ab} f \f$.
+  *
+  **/
+  double *w_ab;
+  nct::allocate ArrayWeights;
+
+  CComplex *Mom_m;         ///< drift-kinetic moments of each \f$ \mu \f$ (shared by threads)
+  nct::allocate ArrayMom_m;
+
   /**
   *    @brief 
   *  
@@ -132,22 +146,23 @@ class Moments
   **/
   Moments(Setup *setup, Vlasov *vlasov, Fields *fields, Grid *grid, Parallel *parallel); 
 
-  /**
-  *   @brief Calculates specific moments of the distribution function
-  *
-  **/
-  void getMoment(const CComplex     f    [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                 const CComplex Field0[Nq][NzLD][Nky][NxLD],
-                 CComplex Mom[8][NsLD][NzLD][Nky][NxLD], 
-                 const int a, const int b, const int idx);
-
   /**
   *   @brief Calculates moments of the phase-space function
   *
-  *   @param s species index
+  *   All moments \f$ M_{00}, M_{20}, M_{02}, M_{10}, M_{30}, M_{12}, M_{22}, M_{04} \f$ 
+  *   are integrated in a single pass over f, gyro-averaged together
+  *   (see Fields::gyroAverageMoments) and summed over the velocity 
+  *   space decomposition by a single reduction.
+  *
+  *   Needs to be called by all threads of a parallel region (or outside 
+  *   of any), the results are available to all threads on return.
+  *
+  *   @param f      phase-space function
+  *   @param Field0 fields (for field corrections)
+  *   @param Mom    moments (not offset)
   *
   **/
-  void getMoments(const CComplex     f    [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
+  void getMoments(const PComplex     f    [NsLD][NmLB][NzLB][NkyLD][NxLB  ][NvLB],
                   const CComplex   Field0[Nq][NzLD][Nky][NxLD],
                         CComplex Mom[8][NsLD][NzLD][Nky][NxLD]); 
 
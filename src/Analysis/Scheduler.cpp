@@ -0,0 +1,156 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: Scheduler.cpp
+ *
+ *    Description: Central scheduling of diagnostics output
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#include "Analysis/Scheduler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+Scheduler::Scheduler(Setup *setup, Parallel *_parallel)
+: parallel(_parallel), plannedStep(-2), numSteps(0), diagTime(0.)
+{
+  maxFraction = setup->get("DataOutput.Scheduler.MaxFraction", 1. );
+  maxDelay    = setup->get("DataOutput.Scheduler.MaxDelay"   , 0  );
+  expensive   = setup->get("DataOutput.Scheduler.Expensive"  , 0.5);
+
+  if((maxFraction <= 0.) || (maxDelay < 0)) check(-1, DMESG("DataOutput.Scheduler : MaxFraction > 0 and MaxDelay >= 0 required"));
+
+  // overdue tasks are executed regardless of the budget, thus without delay the budget has no effect
+  if((maxFraction < 1.) && (maxDelay == 0)) check(-1, DMESG("DataOutput.Scheduler : MaxFraction < 1 requires MaxDelay > 0"));
+}
+
+Scheduler::Task* Scheduler::add(const std::string &name, const Timing &timing, Task *product)
+{
+  tasks.push_back({ name, timing, product, this, false, false, -1, 0., 0., 0, 0, 0 });
+  return &tasks.back();
+}
+
+Scheduler::Task* Scheduler::addProduct(const std::string &name)
+{
+  return add(name, Timing(-1, -1.));
+}
+
+void Scheduler::plan(const Timing &timing, const double dt)
+{
+  if(numSteps++ == 0) start = System::getTimeOfDay();
+
+  plannedStep = timing.step;
+
+  // get due tasks, previous output is skipped if task is still pending
+  bool anyPending = false;
+
+  for(auto &task : tasks) {
+
+    task.run = false;
+
+    if(timing.check(task.timing, dt)) {
+
+      // keep first due step, thus repeatedly deferred tasks get priority
+      if(task.pending) task.numSkipped++;
+      else             task.dueStep = timing.step;
+
+      task.pending = true;
+    }
+
+    anyPending |= task.pending;
+  }
+
+  if(!anyPending) return;
+
+  // use maximum cost and wall time over all processes, thus decisions are identical
+  std::vector<double> cost;
+  for(auto &task : tasks) { cost.push_back(task.lastCost); task.lastCost = 0.; }
+  cost.push_back(System::getTimeDifference(start));
+
+  parallel->reduce(&cost[0], Op::max, DIR_ALL, cost.size());
+
+  int n = 0;
+  for(auto &task : tasks) {
+
+    if(cost[n] > 0.) {
+
+      // average over last executions (cost may change, e.g. with non-linear phase)
+      task.cost = (task.cost == 0.) ? cost[n] : 0.75 * task.cost + 0.25 * cost[n];
+      diagTime += cost[n];
+    }
+    n++;
+  }
+
+  const double wallTime = cost.back(),
+               stepTime = std::max(0., wallTime - diagTime) / numSteps;
+
+  double budget = maxFraction * wallTime - diagTime;
+
+  // longest waiting tasks first (stable, thus otherwise in order of registration)
+  std::vector<Task *> due;
+  for(auto &task : tasks) if(task.pending) due.push_back(&task);
+
+  std::stable_sort(due.begin(), due.end(), [](const Task *a, const Task *b) { return a->dueStep < b->dueStep; });
+
+  bool haveExpensive = false;
+
+  for(auto task : due) {
+
+    // cost of shared product is only accounted once per time step
+    const double taskCost  = task->cost + (((task->product != nullptr) && !task->product->run) ? task->product->cost : 0.);
+    const bool   measured  = (task->cost > 0.),
+                 isExpensive = measured && (taskCost > expensive * stepTime),
+                 isOverdue   = (timing.step - task->dueStep) >= maxDelay;
+
+    // stagger expensive tasks
+    if(isExpensive && haveExpensive && !isOverdue) continue;
+
+    // limit fraction of wall time (unmeasured tasks are executed once to get their cost), 
+    // overdue tasks are always executed, thus no diagnostic is deferred forever
+    if((maxFraction < 1.) && measured && (taskCost > budget) && !isOverdue) continue;
+
+    task->run     = true;
+    task->pending = false;
+    if(task->product != nullptr) task->product->run = true;
+
+    if(task->dueStep != timing.step) task->numDeferred++;
+
+    budget        -= taskCost;
+    haveExpensive |= isExpensive;
+  }
+}
+
+void Scheduler::printStatistics()
+{
+  if(numSteps == 0) return;
+
+  std::stringstream messageStream;
+
+  messageStream << std::endl << "Scheduler | Diagnostics wall time : " << std::setprecision(3) << diagTime << " s "
+                << "(" << 100. * diagTime / std::max(1.e-99, System::getTimeDifference(start)) << "%)" << std::endl;
+
+  for(auto &task : tasks) {
+
+    if(task.numRuns == 0) continue;
+
+    messageStream << "          | " << std::setw(16) << std::left << task.name << std::right
+                  << " Runs : "     << std::setw(6) << task.numRuns
+                  << " Deferred : " << std::setw(6) << task.numDeferred
+                  << " Skipped : "  << std::setw(6) << task.numSkipped
+                  << " Cost : "     << std::scientific << std::setprecision(2) << task.cost << " s" << std::fixed << std::endl;
+  }
+
+  parallel->print(messageStream.str());
+}
+
+void Scheduler::printOn(std::ostream &output) const
+{
+  output << "           | Diagnostics : " << (maxFraction < 1. ? "max. " + Setup::num2str(100. * maxFraction) + "% of wall time" : "no time limit")
+         << ", " << (maxDelay > 0 ? "staggered (max. delay " + Setup::num2str(maxDelay) + " steps)" : "not staggered") << std::endl;
+}
@@ -0,0 +1,202 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: Scheduler.h
+ *
+ *    Description: Central scheduling of diagnostics output
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef __GKC_SCHEDULER_H__
+#define __GKC_SCHEDULER_H__
+
+#include "Global.h"
+
+#include "Setup.h"
+#include "Parallel/Parallel.h"
+#include "Timing.h"
+#include "Tools/System.h"
+
+#include <vector>
+#include <list>
+
+/**
+*
+*   @brief Central scheduler of diagnostics output
+*
+*   Each diagnostic (e.g. scalar values, moments, phase-space output) has
+*   its own Timing, thus several (expensive) diagnostics may fire on the same
+*   time step. The scheduler knows all diagnostics (tasks) and their
+*   measured cost (wall time, maximum over all processes) and decides once
+*   per time step (plan) which of the due tasks are executed :
+*
+*     - Stagger : Only one expensive task (cost larger than a fraction of the
+*                 mean time step) is executed per time step, other due expensive
+*                 tasks are deferred by up to MaxDelay time steps.
+*
+*     - Budget  : A task is deferred if the total wall time spent on diagnostics
+*                 would exceed MaxFraction of the total wall time. If a deferred
+*                 task becomes due again, the previous output is skipped. Tasks
+*                 deferred for MaxDelay time steps (overdue) are executed
+*                 regardless of the budget.
+*
+*     - Sharing : Tasks may depend on an intermediate product (e.g. the moments
+*                 required by fluxes, x-dependent and scalar values), which is
+*                 calculated once per time step. Its cost is only accounted for
+*                 the first task, thus tasks sharing a product are preferably
+*                 executed together.
+*
+*   As all decisions are based on values reduced over all processes, they are
+*   identical on every process (required for collective HDF-5 writes).
+*   Tasks are registered by the modules during initialization, e.g.
+*
+*   \code
+*     taskF1 = fileIO->scheduler->add("Vlasov.F1", dataOutputF1);
+*     ...
+*     if(taskF1->check(timing, dt)) {
+*       Scheduler::Scope cost(taskF1);
+*       ...
+*     }
+*   \endcode
+*
+*   Setup parameters
+*
+*     DataOutput.Scheduler.MaxFraction : maximum fraction of wall time spent on diagnostics
+*                                        (default 1, no limit). Overdue tasks are executed
+*                                        anyway, thus the fraction may be exceeded and 
+*                                        MaxFraction < 1 requires MaxDelay > 0
+*     DataOutput.Scheduler.MaxDelay    : maximum delay of expensive tasks in time steps
+*                                        (default 0, no staggering)
+*     DataOutput.Scheduler.Expensive   : task is expensive if cost is larger than this fraction
+*                                        of the mean wall time of a time step (default 0.5)
+*
+*   If plan is not called for the current time step (e.g. for eigenvalue
+*   solvers), the Timing of the task is used directly.
+*
+**/
+class Scheduler : public IfaceGKC
+{
+ public:
+
+  /**
+  *   @brief Diagnostic task (or intermediate product)
+  *
+  **/
+  struct Task
+  {
+    std::string name;      ///< name of task (for statistics)
+    Timing      timing;    ///< requested output timing
+    Task       *product;   ///< shared intermediate product (or nullptr)
+    Scheduler  *scheduler; ///< scheduler the task belongs to
+
+    bool   pending,        ///< true if task is due but not yet executed
+           run;            ///< true if task is executed in current time step
+    int    dueStep;        ///< time step at which the pending task first became due
+
+    double cost,           ///< measured cost (wall time in seconds, averaged)
+           lastCost;       ///< local cost measured since last planning
+    int    numRuns,        ///< number of executions
+           numDeferred,    ///< number of deferred executions
+           numSkipped;     ///< number of skipped outputs (due again while pending)
+
+    /**
+    *   @brief returns true if task is executed in the current time step
+    *
+    **/
+    bool check(const Timing &t, const double dt) const
+    {
+      return (t.step == scheduler->plannedStep) ? run : t.check(timing, dt);
+    };
+  };
+
+  /**
+  *   @brief Measures cost of task (on master thread) for its life time
+  *
+  **/
+  class Scope
+  {
+    Task    *task;
+    timeval  start;
+
+   public:
+
+    Scope(Task *_task) : task(_task), start(System::getTimeOfDay()) {};
+   ~Scope()
+    {
+      if(omp_get_thread_num() == 0) { task->lastCost += System::getTimeDifference(start); task->numRuns++; }
+    };
+  };
+
+ private:
+
+  Parallel *parallel;
+
+  std::list<Task> tasks;   ///< registered tasks (list, as pointers to tasks are handed out)
+
+  double maxFraction,      ///< maximum fraction of wall time spent on diagnostics
+         expensive;        ///< fraction of mean time step wall time for expensive tasks
+  int    maxDelay;         ///< maximum delay of expensive tasks (time steps)
+
+  int     plannedStep;     ///< time step of last planning
+  int     numSteps;        ///< number of planned time steps
+  double  diagTime;        ///< total wall time spent on diagnostics (reduced)
+  timeval start;           ///< wall clock time of first planning
+
+ public:
+
+  Scheduler(Setup *setup, Parallel *parallel);
+
+  /**
+  *   @brief Register diagnostic task
+  *
+  *   @param name    name of task
+  *   @param timing  requested output timing
+  *   @param product shared intermediate product required by task (see addProduct)
+  *
+  *   @return task handle (valid for life time of scheduler)
+  *
+  **/
+  Task* add(const std::string &name, const Timing &timing, Task *product=nullptr);
+
+  /**
+  *   @brief Register intermediate product shared by tasks
+  *
+  *   Cost of the product is measured by a Scope, it is never executed on
+  *   its own, thus check returns true if any task requiring it is executed.
+  *
+  **/
+  Task* addProduct(const std::string &name);
+
+  /**
+  *   @brief registered tasks (e.g. for telemetry of their cost)
+  *
+  **/
+  const std::list<Task>& getTasks() const { return tasks; };
+
+  /**
+  *   @brief Decide which tasks are executed in current time step
+  *
+  *   Has to be called by all processes (from a single thread) before
+  *   the output of the time step. Communication only takes place if a
+  *   task is pending.
+  *
+  **/
+  void plan(const Timing &timing, const double dt);
+
+  /**
+  *   @brief print statistics of tasks (runs, deferred and skipped outputs, cost)
+  *
+  **/
+  void printStatistics();
+
+ protected:
+
+  virtual void printOn(std::ostream &output) const;
+
+};
+
+#endif // __GKC_SCHEDULER_H__
@@ -69,11 +69,12 @@ Benchmark::Benchmark(Setup *setup, Parallel *_parallel, FileIO *fileIO) : parall
    
 Benchmark::~Benchmark()
 {
-  H5Gclose(benchGroup);
- 
   closeData();
 
+  // table flushes buffered records to group, thus delete before closing it
   delete eventTable;
+  H5Gclose(benchGroup);
+ 
   if(useBenchmark) PAPI_shutdown();
 }
 
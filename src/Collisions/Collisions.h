@@ -52,14 +52,45 @@ public:
   };
 
   /**
+  *  @brief Adds the collisional term to the current Runge-Kutta stage
   *
+  *  Called after the Vlasov kernel has updated ft and fss. As the stage 
+  *  update is linear in dg/dt, the collisional term C is added directly 
+  *  as
+  *
+  *      ft  = ft  +  rk[1] * C
+  *      fss = fss + (rk[2] * rk[1] + 1) * C * dt ,
+  *
+  *  thus no phase-space sized temporary is required.
+  *
+  *  @param fs   phase-space function of the current stage (with ghosts)
+  *  @param ft   Runge-Kutta stage accumulator (see Vlasov::solve)
+  *  @param fss  phase-space function of the next stage
   *
   **/
-  virtual void solve(Fields *fields, const CComplex  *fs, const CComplex *f0, CComplex *Coll, double dt, int rk_step) 
+  virtual void solve(Fields *fields, const PComplex  *fs, const double *f0, 
+                     PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step) 
   {
     // we have collisionless system
   };
 
+  /**
+  *  @brief Collision operator requires velocity moments
+  *
+  *  If true, Fields calculates the moments (see Fields::Mom) 
+  *  together with the source terms.
+  *
+  **/
+  virtual bool requiresMoments() const { return false; };
+
+  /**
+  *  @brief Collision operator is used
+  *
+  *  If false, solve is not called from the Vlasov solver.
+  *
+  **/
+  virtual bool isCollisional() const { return false; };
+
   /**
   *  @brief Derivative of the error function
   *  @image html Deriv_ErrorFunction.png
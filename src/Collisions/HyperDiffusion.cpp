@@ -33,7 +33,8 @@ Collisions_HyperDiffusion::~Collisions_HyperDiffusion()
 }
  
 
-void Collisions_HyperDiffusion::solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step) 
+void Collisions_HyperDiffusion::solve(Fields *fields, const PComplex  *f, const double *f0, 
+                                      PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step) 
 {
  
 
@@ -42,9 +43,14 @@ void Collisions_HyperDiffusion::solve(Fields *fields, const CComplex  *f, const
   
   const double _kw_dv4 = 1./pow4(dv);
 
-  [=](const CComplex f   [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current timestep
-      const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Background Maxwellian
-            CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB][NvLB]   // Collisional term
+  // collisional term enters the stage update as dg/dt does (see Collisions::solve)
+  const double c_ft  =  rk[1];
+  const double c_fss = (rk[2] * rk[1] + 1.) * dt;
+
+  [=](const PComplex f   [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current timestep
+      const double   f0  [NsLD][NmLB][NzLB]     [NxLB][NvLB],  // Background Maxwellian
+            PComplex ft  [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Runge-Kutta stage accumulator
+            PComplex fss [NsLD][NmLB][NzLB][Nky][NxLB][NvLB]   // Phase-space function of next stage
      ) 
   {
     for(int s = NsLlD; s <= NsLuD; s++) {
@@ -62,7 +68,10 @@ void Collisions_HyperDiffusion::solve(Fields *fields, const CComplex  *f, const
       const int    sc_idx[]  = { v-2, v-1,    v, v+1, v+2};  // stencil index
       const double sc_val[]  = { 1., -4., 6., -4., 1.};  // stencil values
 
-      Coll[s][m][z][y_k][x][v] = -beta[s] * _kw_dv4 * __sec_reduce_add(sc_val[:] * f[s][m][z][y_k][x][sc_idx[:]]);
+      const CComplex C_ = -beta[s] * _kw_dv4 * __sec_reduce_add(sc_val[:] * f[s][m][z][y_k][x][sc_idx[:]]);
+
+      ft [s][m][z][y_k][x][v] += c_ft  * C_;
+      fss[s][m][z][y_k][x][v] += c_fss * C_;
                  
     } // v
 
@@ -70,7 +79,7 @@ void Collisions_HyperDiffusion::solve(Fields *fields, const CComplex  *f, const
     
     } // s
    
-  } ((A6zz) f, (A6zz) f0, (A6zz) Coll); 
+  } ((A6pp) f, (A5rr) f0, (A6pp) ft, (A6pp) fss); 
 }
 
 
@@ -63,7 +63,14 @@ class Collisions_HyperDiffusion : public Collisions {
   *
   *
   **/
-  void solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step); 
+  void solve(Fields *fields, const PComplex  *f, const double *f0, 
+             PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step); 
+
+  /**
+  *   Collisions are only used for non-zero collisionality
+  *
+  **/
+  bool isCollisional() const { return __sec_reduce_add(std::abs(beta[NsGlD:Ns])) > 0.; };
 
  protected:
 
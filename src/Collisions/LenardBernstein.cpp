@@ -27,11 +27,11 @@ Collisions_LenardBernstein::Collisions_LenardBernstein(Grid *grid, Parallel *par
   for(int s = 0; s <= NsGuD; s++) beta[s] = setup->get("Collisions.Species" + Setup::num2str(s) + ".Beta", 0.e0);
    
   // allocate arrays
-  ArrayPreFactors     = nct::allocate(grid->RsLD, grid->RmLD , grid->RvLD)(&a , &b , &c , &nu);
-  ArrayCorrectionTerm = nct::allocate(grid->RzLD, grid->RkyLD, grid->RxLD)(&dn, &dP, &dE);
+  // Note : moments dn, dP, dE are calculated by Fields (see requiresMoments)
+  ArrayPreFactors     = nct::allocate(grid->RsLD, grid->RmLD , grid->RvLD)(&a , &b , &c);
       
   // as some terms include complicated functions we pre-calculate them 
-  calculatePreTerms((A3rr) a, (A3rr) b, (A3rr) c, (A3rr) nu);
+  calculatePreTerms((A3rr) a, (A3rr) b, (A3rr) c);
 
   initData(setup, fileIO);
 }
@@ -45,7 +45,7 @@ Collisions_LenardBernstein::~Collisions_LenardBernstein()
  
 
 void Collisions_LenardBernstein::calculatePreTerms(double a[NsLD][NmLD][NvLD], double  b[NsLD][NmLD][NvLD], 
-                                                   double c[NsLD][NmLD][NvLD], double nu[NsLD][NmLD][NvLD])
+                                                   double c[NsLD][NmLD][NvLD])
 {
 
   for(int s = NsLlD; s <= NsLuD; s++) { 
@@ -54,7 +54,6 @@ void Collisions_LenardBernstein::calculatePreTerms(double a[NsLD][NmLD][NvLD], d
     // v = v_\parallel^2 + 2 \mu  / v_{\sigma, th}^2
     const double v_ = ( pow2(V[v]) + 2. * M[m] ) / pow2(species[s].v_th);
 
-    nu[s][m][v] = v_ * dv * grid->dm[m]; // directly normalize 
     a [s][m][v] = 1. - 3. * sqrt(M_PI/2.) * ( erf(v_) - Derf(v_)) * pow(v_, -0.5);
     b [s][m][v] = V[v] * pow(v_, -3./2.) * erf(v_)    ;
     c [s][m][v] = pow(v_,-1./2.) *  (erf(v_) - Derf(v_)) ;
@@ -64,47 +63,37 @@ void Collisions_LenardBernstein::calculatePreTerms(double a[NsLD][NmLD][NvLD], d
 
 
 
-void Collisions_LenardBernstein::solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step) 
+void Collisions_LenardBernstein::solve(Fields *fields, const PComplex  *f, const double *f0, 
+                                       PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step) 
 {
 
   // Don't calculate collisions if collisionality is set to zero
   if (__sec_reduce_add(std::abs(beta[NsGlD:Ns])) == 0.) return;
 
-  [=](const CComplex f   [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current timestep
-      const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Background Maxwellian
-            CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Collisional term
-            CComplex dn              [NzLD][Nky][NxLD]      ,
-            CComplex dP              [NzLD][Nky][NxLD]      ,
-            CComplex dE              [NzLD][Nky][NxLD]      ,
+  if(consvMoment && (fields->Mom == nullptr)) check(-1, DMESG("Velocity moments not calculated by Fields"));
+
+  // collisional term enters the stage update as dg/dt does (see Collisions::solve)
+  const double c_ft  =  rk[1];
+  const double c_fss = (rk[2] * rk[1] + 1.) * dt;
+
+  [=](const PComplex f   [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current timestep
+      const double   f0  [NsLD][NmLB][NzLB]     [NxLB][NvLB],  // Background Maxwellian
+            PComplex ft  [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Runge-Kutta stage accumulator
+            PComplex fss [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Phase-space function of next stage
+      const CComplex Mom      [3][NsLD][NzLD][Nky][NxLD]      ,  // Velocity moments (from Fields)
             const double a [NsLD][NmLD][NvLD],
             const double b [NsLD][NmLD][NvLD],
-            const double c [NsLD][NmLD][NvLD],
-            const double nu[NsLD][NmLD][NvLD]
+            const double c [NsLD][NmLD][NvLD]
      ) 
   {
 
-    for(int s = NsLlD; s <= NsLuD; s++) {  if(consvMoment) {
-    for(int m = NmLlD; m <= NmLuD; m++) { 
-
-      // (1) Calculate Moments (note : can we recycle Fields  n, P ?)
-      const double pre_dvdm = species[s].n0 * plasma->B0 * dv * grid->dm[m] ;
-
-      #pragma omp for collapse(2)
-      for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
-      for(int x = NxLlD; x <= NxLuD; x++) {
-
-        dn[z][y_k][x] = __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD]                       ) * pre_dvdm;
-        dP[z][y_k][x] = __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD] * V       [NvLlD:NvLD]) * pre_dvdm;
-        dE[z][y_k][x] = __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD] * nu[s][m][NvLlD:NvLD]);
-
-        
-      } } } }
-          
-      // need to communicate with other CPU's ? 
-    }
+    for(int s = NsLlD; s <= NsLuD; s++) {  
           
-    
-    // b-cast dn, dP, dE 
+    // (1) Moments are calculated together with the field source terms in Fields::solve 
+    //     (need to communicate with other CPU's ? )
+    const double pre_nB   = species[s].n0 * plasma->B0;
+    const double _kw_vth2 = 1./pow2(species[s].v_th);
+
     const double _kw_12_dv_dv = 1./(12. * pow2(dv)); // use from e.g. Grid ?
     const double _kw_12_dv    = 1./(12. * dv )     ;
 
@@ -124,24 +113,26 @@ void Collisions_LenardBernstein::solve(Fields *fields, const CComplex  *f, const
                               -  30.*f[s][m][z][y_k][x][v]) * _kw_12_dv_dv;
       const double v2_rms    = 1.;//pow2(alpha)
         
-      Coll[s][m][z][y_k][x][v] =
+      const CComplex C_ =
                  
         beta[s]  * (f_  + V[v] * df_dv + v2_rms * ddf_dvv)           ///< Lennard-Bernstein Collision term
         // add conservation terms 
         + (consvMoment ?
-          (a[s][m][v] * dn[z][y_k][x] +                           ///< Density  correction   
-           b[s][m][v] * dP[z][y_k][x] +                           ///< Momentum correction
-           c[s][m][v] * dE[z][y_k][x]) * f0[s][m][z][y_k][x][v]   ///< Energy   correction
-                       : 0.);
+          (a[s][m][v] * Mom[VMoment::n][s][z][y_k][x] * pre_nB   +   ///< Density  correction   
+           b[s][m][v] * Mom[VMoment::P][s][z][y_k][x] * pre_nB   +   ///< Momentum correction
+           c[s][m][v] * Mom[VMoment::E][s][z][y_k][x] * _kw_vth2 )   ///< Energy   correction
+                      * f0[s][m][z][x][v] : 0.);
+
+      ft [s][m][z][y_k][x][v] += c_ft  * C_;
+      fss[s][m][z][y_k][x][v] += c_fss * C_;
 
     } // v
 
     } } } } // x, y_k, z, m 
          
    
-  } } ((A6zz) f  , (A6zz) f0, (A6zz) Coll, 
-       (A3zz) dn , (A3zz) dP, (A3zz) dE, 
-       (A3rr) a  , (A3rr) b , (A3rr)  c, (A3rr) nu);
+  } } ((A6pp) f  , (A5rr) f0, (A6pp) ft, (A6pp) fss, (A5zz) fields->Mom,
+       (A3rr) a  , (A3rr) b , (A3rr)  c);
 };
 
 
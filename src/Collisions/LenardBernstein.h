@@ -46,17 +46,11 @@ class Collisions_LenardBernstein : public Collisions {
   double beta[SPECIES_MAX+1];         ///< Collisionality 
   bool   consvMoment;  ///< Set if 0-2 Moments are conserved
 
-  double *nu,   ///<            \f$ \nu = \left( v_\parallel^2 + 2 \mu \right) / v_{th}^2       \f$
-         *a ,   ///< Pre-factor \f$ a   = 1 - \frac{\pi}{2}\left( erf - derf \right) \nu^{-1/2} \f$
+  double *a ,   ///< Pre-factor \f$ a   = 1 - \frac{\pi}{2}\left( erf - derf \right) \nu^{-1/2} \f$
          *b ,   ///< Pre-factor \f$ b   = v_\parallel x\nu^{-3/2} erf(x)                        \f$
          *c ;   ///< Pre-factor \f$ c   = \nu^{-1/2} \left(  erf(\nu) - erf'(\nu) \right)       \f$
 
-  CComplex *dn, ///< \f$ \int f_{1\sigma} dv_\parallel d\mu             \f$
-           *dP, ///< \f$ \int f_{1\sigma} v_\parallel dv_\parallel d\mu \f$
-           *dE; ///< \f$ \int f_{1\sigma} \nu dv_\parallel d\mu         \f$
-   
-  nct::allocate ArrayPreFactors    , ///< Array class for dn, dP, dE
-                ArrayCorrectionTerm; ///< Array class for nu, a, b, c
+  nct::allocate ArrayPreFactors; ///< Array class for a, b, c
 
   /**
   *   @brief calculates the pre-terms
@@ -70,7 +64,7 @@ class Collisions_LenardBernstein : public Collisions {
   *
   **/ 
   void calculatePreTerms(double a[NsLD][NmLD][NvLD], double  b[NsLD][NmLD][NvLD], 
-                         double c[NsLD][NmLD][NvLD], double nu[NsLD][NmLD][NvLD]);
+                         double c[NsLD][NmLD][NvLD]);
 
  public:
 
@@ -90,12 +84,28 @@ class Collisions_LenardBernstein : public Collisions {
   **/ 
  ~Collisions_LenardBernstein();
  
+  /**
+  *   Moments \f$ (dn, dP, dE) \f$ are required for the conservation terms
+  *   and are calculated by Fields together with the source terms.
+  *
+  **/
+  bool requiresMoments() const { return consvMoment; };
+
   /**
   *   Calculate Collisional corrections
   *
+  *   @note the velocity moments in fields->Mom are calculated from the same f
+  *         in Fields::solve, which is called directly before.
+  *
+  **/
+  void solve(Fields *fields, const PComplex  *f, const double *f0, 
+             PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step); 
+
+  /**
+  *   Collisions are only used for non-zero collisionality
   *
   **/
-  void solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step); 
+  bool isCollisional() const { return __sec_reduce_add(std::abs(beta[NsGlD:Ns])) > 0.; };
 
  protected:
 
@@ -3,128 +3,194 @@
  *
  *       Filename: PitchAngle.cpp
  *
- *    Description: Implementation of the Pitch angle scattering 
+ *    Description: Implementation of the Pitch angle scattering
  *
- *         Author: Paul P. Hilscher (2012), 
+ *         Author: Paul P. Hilscher (2012),
  *
  *        License: GPLv3+
  * =====================================================================================
  */
 
 #include "Collisions/PitchAngle.h"
+#include "Tools/ScratchArena.h"
 
 
-Collisions_PitchAngle::Collisions_PitchAngle(Grid *grid, Parallel *parallel, Setup *setup, FileIO *fileIO, Geometry *geo) 
-: Collisions(grid, parallel, setup, fileIO, geo) 
+Collisions_PitchAngle::Collisions_PitchAngle(Grid *grid, Parallel *parallel, Setup *setup, FileIO *fileIO, Geometry *geo)
+: Collisions(grid, parallel, setup, fileIO, geo)
 {
 
-  nu    = setup->get("Vlasov.Collision.Nu", 0.e0);
-  
-  double lambda_C = setup->get("Collisions.CoulombLogarithm", 1.e-4);
-     /* 
-  double  e = 1.; 
-  
-  vc = M_PI * log(lambda_C) * pow4(e) * plasma->n_ref * plasma->L_ref / (cbrt(2.) * pow2(plasma->T_ref));
-
-  pref_Cxy.resize(grid->RsGD); pref_Cxy = 0.;
-  B.resize(grid->RsGD, Range(1,4)); B = 0.;
-  
-  // we need to calculate the pre-factors
-  //
-  //        for(int s=NsGlD; s <= NsGuD; s++)  pref_Cxy(s) += - vc * species(j).n * pow2(species(j).q)* species(j).T * pow(species[s].m, 3./2.) 
-
-  // calculate B's for conservation term
-        double v2 = pow2(V[v]) + M[m]; 
- 
-        B(s,1) = parallel->sum(sum(F0), DIR_ALL);
-        B(s,1) = parallel->sum(sum(F0), DIR_ALL);
-        :1
-        B(s,1) = parallel->sum(sum(F0), DIR_ALL);
-        B(s,1) = parallel->sum(sum(F0), DIR_ALL);
-
-      * */ 
-  
-  // normalized velocity : double x = v/v_th;
-}
+  // Get beta_C for each species
+  for(int s = 0; s <= NsGuD; s++) beta[s] = setup->get("Collisions.Species" + Setup::num2str(s) + ".Beta", 0.e0);
 
-void Collisions_PitchAngle::C_xy(const double df_dp, const int x, const int y, const int z, const int v, const int m, const int s) 
-{
-  /* 
-  const double xc = 0.;
-  
-  return pref_Cxy(s) * 1./pow5(V[v]) * ( V[v] * F1(xc) + 3. * plasma->B0 * M[m] * df_dp / species[s].m * F2(df_dp));
-  */
+  // the mu-derivative requires ghost cells in m (also for decomposition in m)
+  if((Nm > 1) && (NmLlD == NmLlB)) check(-1, DMESG("PitchAngle requires ghost cells in mu, set Grid.NmBoundary = 1"));
+
+  // the mixed derivative requires corner ghost cells (m,v), which are only set (to zero) at global boundaries
+  if((parallel->decomposition[DIR_V] > 1) && (parallel->decomposition[DIR_M] > 1)) 
+    check(-1, DMESG("PitchAngle does not support decomposition in both v and mu"));
+
+  // allocate arrays
+  ArrayCoeff   = nct::allocate(grid->RsLD, grid->RmLB, grid->RvLB)(&D_vv, &D_vm, &D_mm);
+  ArrayStencil = nct::allocate(grid->RmLB)(&w_ml, &w_mc, &w_mu);
+
+  // as coefficients include complicated functions we pre-calculate them
+  calculatePreTerms((A3rr) D_vv, (A3rr) D_vm, (A3rr) D_mm);
+
+  initData(setup, fileIO);
 }
 
 
-void Collisions_PitchAngle::C_vm(const double df_dv, const double df_dm, const double f, const int x, const int y, const int z, const int v, const int m, const int s) 
+void Collisions_PitchAngle::calculatePreTerms(double D_vv[NsLD][NmLB][NvLB], double D_vm[NsLD][NmLB][NvLB],
+                                              double D_mm[NsLD][NmLB][NvLB])
 {
-  /* 
-  int j = s;
-  
-  const double xc = species[s].v_th / species(j).v_th * V[v];
-  
-  // parallel velocity
-  const double C_v = ((2. * plasma->B0 * M[m])/ species[s].m * F1(xc) + pow2(V[v]) * F3(x)) * df_dv + (6. * M[m] * pow2(V[v]) * F2(xc)) * df_dm - 2. * F3(xc)/pow3(V[v]) * V[v] * f;
-  const double C_m = ((6. * M[m] * V[v] * F2(xc)) * df_dv  + 4./plasma->B0 * pow2(V[v]) * M[m] * F1(xc)) * df_dv + (4. * pow2(M[m]) * F3(xc)) * df_dm - 2. * F3(xc)/pow3(V[v]) * 2. * M[m] * f;
-        
-  // BUG : this is wrong, we need to differentiate over v
-  const double Cvm = (C_v + C_m) / dv;
-
-  return Cvm;
-
-  */
+  const double B0 = plasma->B0;
+
+  // coefficients are zero outside the global domain, which gives zero flux over the boundary
+  for(int s = NsLlD; s <= NsLuD; s++) {
+  for(int m = NmLlB; m <= NmLuB; m++) { simd_for(int v = NvLlB; v <= NvLuB; v++) {
+
+    const bool   inside = (m >= NmGlD) && (m <= NmGuD) && (Nm > 1);
+
+    // x^2 = (v_\parallel^2 + \mu B_0) / v_{\sigma, th}^2
+    const double x      = inside ? sqrt((pow2(V[v]) + M[m] * B0) / pow2(species[s].v_th)) : 0.;
+    const double nu_D   = (x > 1.e-8) ? beta[s] * (erf(x) - Chandra(x)) / pow3(x) : 0.;
+
+    // M is only defined inside the global domain
+    D_vv[s][m][v] = inside ?   nu_D * 2.  * B0 * M[m]           : 0.;
+    D_vm[s][m][v] = inside ? - nu_D * 4.  * M[m] * V[v]         : 0.;
+    D_mm[s][m][v] = inside ?   nu_D * 8./B0 * pow2(V[v]) * M[m] : 0.;
+
+  } } } // s, m, v
+
+  // Stencil weights for non-equidistant first derivative in mu (second order),
+  // one-sided at the lower/upper global boundary
+  for(int m = NmLlB; m <= NmLuB; m++) {
+
+    w_ml[m] = 0.; w_mc[m] = 0.; w_mu[m] = 0.;
+
+    if((Nm == 1) || (m < NmGlD) || (m > NmGuD)) continue;
+
+    if     (m == NmGlD) { w_mc[m] = -1./(M[m+1] - M[m]); w_mu[m] = -w_mc[m]; }
+    else if(m == NmGuD) { w_ml[m] = -1./(M[m] - M[m-1]); w_mc[m] = -w_ml[m]; }
+    else {
+
+      const double h_l = M[m  ] - M[m-1];
+      const double h_u = M[m+1] - M[m  ];
+
+      w_ml[m] = - h_u / (h_l * (h_l + h_u));
+      w_mc[m] =   (h_u - h_l) / (h_l * h_u);
+      w_mu[m] =   h_l / (h_u * (h_l + h_u));
+    }
+  }
 }
 
-void Collisions_PitchAngle::solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step)
+
+void Collisions_PitchAngle::solve(Fields *fields, const PComplex  *f, const double *f0, 
+                                  PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step)
 {
 
-  [=](const CComplex f   [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current time step
-      const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  // Background Maxwellian
-            CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB][NvLB]   // Collisional term
-     ) 
+  // Don't calculate collisions if collisionality is set to zero
+  if (__sec_reduce_add(std::abs(beta[NsGlD:Ns])) == 0.) return;
+
+  // collisional term enters the stage update as dg/dt does (see Collisions::solve)
+  const double c_ft  =  rk[1];
+  const double c_fss = (rk[2] * rk[1] + 1.) * dt;
+
+  [=](const PComplex f   [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Phase-space function for current time step
+      const double   f0  [NsLD][NmLB][NzLB]     [NxLB][NvLB],  // Background Maxwellian
+            PComplex ft  [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Runge-Kutta stage accumulator
+            PComplex fss [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  // Phase-space function of next stage
+      const double D_vv[NsLD][NmLB][NvLB],
+      const double D_vm[NsLD][NmLB][NvLB],
+      const double D_mm[NsLD][NmLB][NvLB]
+     )
   {
 
+    const double _kw_2_dv = 1./(2.*dv);
 
-  CComplex C_v[NmLD][NvLD];
-  CComplex C_m[NmLD][NvLD];
+    // fluxes are required with one ghost layer in v and (if used) m
+    const int NmF = (Nm > 1) ? 1 : 0;
 
-  const double _kw_12_dv = 1./(12.*dv);
+    // thread local flux arrays, indexed [m - NmLlD + 1][v - NvLlD + 1]
+    ScratchArena::Frame frame;
 
- // Take care m-space may be not equidistant discretized
-  for(int s = NsLlD; s <= NsLuD; s++) {
-  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = 0     ; y_k <= Nky-2; y_k++) {
-  for(int x = NxLlD; x <= NxLuD; x++) { 
+    CComplex (*C_v)[NvLD+2] = (CComplex (*)[NvLD+2]) ScratchArena::get<CComplex>((NmLD+2) * (NvLD+2)),
+             (*C_m)[NvLD+2] = (CComplex (*)[NvLD+2]) ScratchArena::get<CComplex>((NmLD+2) * (NvLD+2));
 
-  for(int m = NmLlD; m <= NmLuD; m++) { const double _kw_12_dm = 1./(12.*grid->dm[m]);
-  for(int v = NvLlD; v <= NvLuD; v++) { 
+    for(int s = NsLlD; s <= NsLuD; s++) {
 
-    const CComplex df_dv = (8.*(f[s][m][z][y_k][x][v+1] - f[s][m][z][y_k][x][v-1]) - (f[s][m][z][y_k][x][v+2] - f[s][m][z][y_k][x][v-2]))/(12.*dv);
-    const CComplex df_dm = (8.*(f[s][m+1][z][y_k][x][v] - f[s][m-1][z][y_k][x][v]) - (f[s][m+2][z][y_k][x][v] - f[s][m-2][z][y_k][x][v]))/(12.*dm);
+    // Note : we do not evolve highest mode (Nyquist)
+    #pragma omp for collapse(3) nowait
+    for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = 0; y_k < Nky-1; y_k++) {
+    for(int x = NxLlD; x <= NxLuD; x++) {
 
-    C_v[m-NmLlD][v-NvLlD] =   (2. * plasma->B0 * M[m]) * df_dv -   ( 4. * M[m] * V[v]                 ) * df_dm; 
-    C_m[m-NmLlD][v-NvLlD] = - (4. * M[m] * V[v]      ) * df_dv +   ( 8./plasma->B0 * pow2(V[v]) * M[m]) * df_dm;
-  } }
+      //////////////////////// Calculate fluxes //////////////////////////
+      for(int m = NmLlD-NmF; m <= NmLuD+NmF; m++) {
 
-  for(int m = NmLlD; m <= NmLuD; m++) { for(int v = NvLlD; v <= NvLuD; v++) { 
-        
-      // use 4-th order central differences
-      Coll[s][m][z][y_k][x][v] =  ( 8. * (C_v[v+1][m] +  C_v[v-1][m]) - (C_v[v+2][m] - C_v[v-2][m])) / (12.*dv) 
-                                + ( 8. * (C_m[v][m+1] +  C_v[v][m-1]) - (C_v[v][m+1] - C_v[v][m-1])) / (12.*dm);
-  } }
+        const double w_l = w_ml[m], w_c = w_mc[m], w_u = w_mu[m];
 
-  } } } }
-  
-  } ((A6zz) f  , (A6zz) f0, (A6zz) Coll); 
+        simd_for(int v = NvLlD-1; v <= NvLuD+1; v++) {
+
+          const CComplex df_dv = (f[s][m][z][y_k][x][v+1] - f[s][m][z][y_k][x][v-1]) * _kw_2_dv;
+          const CComplex df_dm = NmF ? w_l * f[s][m-NmF][z][y_k][x][v] + w_c * f[s][m][z][y_k][x][v]
+                                     + w_u * f[s][m+NmF][z][y_k][x][v] : 0.;
+
+          C_v[m-NmLlD+1][v-NvLlD+1] = D_vv[s][m][v] * df_dv + D_vm[s][m][v] * df_dm;
+          C_m[m-NmLlD+1][v-NvLlD+1] = D_vm[s][m][v] * df_dv + D_mm[s][m][v] * df_dm;
+        }
+      }
+
+      //////////////////////// Divergence of fluxes ///////////////////////
+      for(int m = NmLlD; m <= NmLuD; m++) {
+
+        const int    m_ = m - NmLlD + 1;
+        const double w_l = w_ml[m], w_c = w_mc[m], w_u = w_mu[m];
+
+        simd_for(int v = NvLlD; v <= NvLuD; v++) {
+
+          const int v_ = v - NvLlD + 1;
+
+          const CComplex C_ = (C_v[m_][v_+1] - C_v[m_][v_-1]) * _kw_2_dv
+                            + (NmF ? w_l * C_m[m_-NmF][v_] + w_c * C_m[m_][v_] + w_u * C_m[m_+NmF][v_] : 0.);
+
+          ft [s][m][z][y_k][x][v] += c_ft  * C_;
+          fss[s][m][z][y_k][x][v] += c_fss * C_;
+        }
+      }
+
+    } } } // x, y_k, z
+
+    } // s
+
+  } ((A6pp) f  , (A5rr) f0, (A6pp) ft, (A6pp) fss,
+     (A3rr) D_vv, (A3rr) D_vm, (A3rr) D_mm);
 }
 
-void Collisions_PitchAngle::initData(hid_t fileID) 
+
+void Collisions_PitchAngle::printOn(std::ostream &output) const
 {
 
-}   
-     
+  auto arr2str = [=](const double *val, const int len) -> std::string {
+
+    int prec = 2;
+    std::ostringstream ss;
+    ss << std::setprecision(prec) << std::scientific;
+
+    // only add " / "  between two numbers
+    for(int n = 0; n < len; n++) ss << val[n] << ( n == len-1 ? "" : " / ");
+
+    return ss.str();
+  };
 
-void Collisions_PitchAngle::printOn(std::ostream &output) const 
+  output   << "Collisions |  Pitch-Angle  β = " << arr2str(&beta[1], Ns) << std::endl;
+}
+
+void Collisions_PitchAngle::initData(Setup *setup, FileIO *fileIO)
 {
-  output   << "Collisions |  Pitch-Angle " << ((nu > 0.) ? Setup::num2str(nu) :  "off") << std::endl;
+  hid_t collisionGroup = fileIO->newGroup("Collisions");
+
+  check(H5LTset_attribute_string(collisionGroup, ".", "Model", "Pitch-Angle"), DMESG("H5LTset_attribute"));
+  check(H5LTset_attribute_double(collisionGroup, ".", "Beta" ,  beta, Ns+1), DMESG("H5LTset_attribute"));
+
+  H5Gclose(collisionGroup);
 }
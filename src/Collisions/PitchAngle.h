@@ -3,9 +3,9 @@
  *
  *       Filename: PitchAngle.h
  *
- *    Description: Implementation of the Pitch angle scattering 
+ *    Description: Implementation of the Pitch angle scattering
  *
- *         Author: Paul P. Hilscher (2012), 
+ *         Author: Paul P. Hilscher (2012),
  *
  *        License: GPLv3+
  * =====================================================================================
@@ -16,50 +16,111 @@
 
 #include "Collisions/Collisions.h"
 
-/* 
+/**
 *
-*  @brief Pitch-Angle scattering 
+*  @brief Pitch-Angle scattering
 *
-*  Warning this is package is broken and does nothing yet.
+*  The (Lorentz) pitch-angle scattering operator in \f$ (v_\parallel, \mu) \f$
+*  coordinates is written in conservative (flux) form
+*
+*  \f[
+*      \mathcal{C}_{PA} = \frac{\partial C_v}{\partial v_\parallel} + \frac{\partial C_\mu}{\partial \mu}
+*  \f]
+*
+*  with the fluxes
+*
+*  \f{align}{
+*      C_v   &= \nu_D(x) \left(   2 B_0 \mu \frac{\partial f}{\partial v_\parallel}
+*                               - 4 \mu v_\parallel \frac{\partial f}{\partial \mu} \right) \\
+*      C_\mu &= \nu_D(x) \left( - 4 \mu v_\parallel \frac{\partial f}{\partial v_\parallel}
+*                               + \frac{8}{B_0} v_\parallel^2 \mu \frac{\partial f}{\partial \mu} \right)
+*  \f}
+*
+*  and the deflection frequency \f$ \nu_D(x) = \beta_\sigma \left( erf(x) - Chandra(x) \right) / x^3 \f$,
+*  where \f$ x^2 = \left( v_\parallel^2 + \mu B_0 \right) / v_{th}^2 \f$.
+*
+*  As the diffusion coefficients depend only on \f$ (\sigma, \mu, v_\parallel) \f$ they are
+*  pre-calculated. The fluxes are calculated line-wise over \f$ v_\parallel \f$ for each
+*  \f$ (z, k_y, x) \f$ point and directly differentiated afterwards.
+*
+*  The \f$ \mu \f$-grid is not equidistant, thus we use second order non-uniform
+*  central differences (one-sided at the global boundaries, where we set the flux to
+*  zero). The operator requires ghost cells in \f$ \mu \f$ (Grid.NmBoundary = 1),
+*  which allows domain decomposition in \f$ \mu \f$. The mixed derivatives require the
+*  corner ghost cells \f$ (\mu, v_\parallel) \f$, which are not exchanged, thus \f$ \mu \f$ and
+*  \f$ v_\parallel \f$ may not be decomposed at the same time.
 *
 *   Reference:
 *
 *     PhD Thesis of Merz
 *
-*
-*/
+**/
 class Collisions_PitchAngle : public Collisions {
-    
-    double nu; ///< Collisional frequency 
 
-public:   
-    
-  Collisions_PitchAngle(Grid *grid, Parallel *parallel, Setup *setup, FileIO *fileIO, Geometry *geo);
+ protected:
+
+  double beta[SPECIES_MAX+1]; ///< Collisionality
+
+  double *D_vv,  ///< Diffusion coefficient \f$ \nu_D 2 B_0 \mu                 \f$
+         *D_vm,  ///< Diffusion coefficient \f$ -\nu_D 4 \mu v_\parallel        \f$
+         *D_mm;  ///< Diffusion coefficient \f$ \nu_D 8/B_0 v_\parallel^2 \mu   \f$
+
+  double *w_ml,  ///< Stencil weight for \f$ \partial_\mu \f$ at \f$ m-1 \f$
+         *w_mc,  ///< Stencil weight for \f$ \partial_\mu \f$ at \f$ m   \f$
+         *w_mu;  ///< Stencil weight for \f$ \partial_\mu \f$ at \f$ m+1 \f$
+
+  nct::allocate ArrayCoeff  , ///< Array class for D_vv, D_vm, D_mm
+                ArrayStencil; ///< Array class for w_ml, w_mc, w_mu
 
   /**
-  *    \f[ \left< C_{\sigma j}^{\perp} \right> = - \frac{1}{v^5} \left( 2 v^2 F_1 + 3 B_0 \mu F_2  \right) \nabla_\perp f_\sigma \f]
+  *   @brief calculates the diffusion coefficients and the (non-uniform)
+  *          stencil weights in \f$ \mu \f$
   *
   **/
-  void C_xy(const double df_dp, const int x, const int y, const int z, const int v, const int m, const int s);
-        
+  void calculatePreTerms(double D_vv[NsLD][NmLB][NvLB], double D_vm[NsLD][NmLB][NvLB],
+                         double D_mm[NsLD][NmLB][NvLB]);
+
+public:
+
   /**
-  *    \f[ \left< C_{\sigma j}^{\perp} \right> = - \frac{1}{v^5} \left( 2 v^2 F_1 + 3 B_0 \mu F_2  \right) \nabla_\perp f_\sigma \f]
+  *
+  *   @brief constructor
+  *
+  *   accepts following setup parameters
+  *
+  *     Collisions.Species<s>.Beta : collisionality of species s
   *
   **/
-  void C_vm(const double df_dv, const double df_dm, const double f, const int x, const int y, const int z, const int v, const int m, const int s);
-  
+  Collisions_PitchAngle(Grid *grid, Parallel *parallel, Setup *setup, FileIO *fileIO, Geometry *geo);
+
   /**
   *   Calculate Collisional corrections
   *
   *
   **/
-  void solve(Fields *fields, const CComplex  *f, const CComplex *f0, CComplex *Coll, double dt, int rk_step); 
+  void solve(Fields *fields, const PComplex  *f, const double *f0, 
+             PComplex *ft, PComplex *fss, const double rk[3], double dt, int rk_step);
+
+  /**
+  *   Collisions are only used for non-zero collisionality
+  *
+  **/
+  bool isCollisional() const { return __sec_reduce_add(std::abs(beta[NsGlD:Ns])) > 0.; };
 
-  
-  virtual void initData(hid_t fileID);
-     
  protected:
 
+  /**
+  *   Set Data output parameters
+  *
+  *
+  **/
+  virtual void initData(Setup *setup, FileIO *fileIO);
+
+  /**
+  * Program output
+  *
+  *
+  **/
   virtual void printOn(std::ostream &output) const;
 };
 
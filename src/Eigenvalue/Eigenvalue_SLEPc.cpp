@@ -164,7 +164,7 @@ void Eigenvalue_SLEPc::solve(Vlasov *vlasov, Fields *fields, Visualization *visu
    
       
       // Copy back PETSc solution vector to array
-      [=](CComplex fs[NsLD][NmLD][NzLB][Nky][NxLB][NvLB]) {
+      [=](PComplex fs[NsLD][NmLB][NzLB][Nky][NxLB][NvLB]) {
 
       
         // copy whole phase space function (important due to boundary conditions)
@@ -178,7 +178,7 @@ void Eigenvalue_SLEPc::solve(Vlasov *vlasov, Fields *fields, Visualization *visu
         
         }}} }}}
       
-      }((A6zz) vlasov->fs);
+      }((A6pp) vlasov->fs);
            
       fields->solve(vlasov->f0,  vlasov->fs); 
    
@@ -197,8 +197,10 @@ Eigenvalue_SLEPc::~Eigenvalue_SLEPc()
 
   // check error code of SLEPc finalize
   SlepcFinalize();  
-  H5Gclose(eigvGroupID);
+
+  // table flushes buffered records to group, thus delete before closing it
   delete EVTable;
+  H5Gclose(eigvGroupID);
 }
 
 void Eigenvalue_SLEPc::printOn(std::ostream &output) const 
@@ -66,6 +66,13 @@ FFTSolver::FFTSolver(Setup *setup, Parallel *_parallel, Geometry *_geo, double _
        
   parseSuppressMode(setup->get("SuppressModeX", ""), suppressModeX);  
   parseSuppressMode(setup->get("SuppressModeY", ""), suppressModeY);  
+
+  // Nyquist mode is not evolved, thus by default excluded 
+  Y_NkyIn  = setup->get("FFTSolver.Y.NkyIn" , Nky-1);
+  Y_NkyOut = setup->get("FFTSolver.Y.NkyOut", Nky-1);
+  
+  if((Y_NkyIn  < 1) || (Y_NkyIn  > Nky)) check(-1, DMESG("FFTSolver.Y.NkyIn  out of range (1 <= NkyIn  <= Nky)"));
+  if((Y_NkyOut < 1) || (Y_NkyOut > Nky)) check(-1, DMESG("FFTSolver.Y.NkyOut out of range (1 <= NkyOut <= Nky)"));
 };
 
 
@@ -32,7 +32,7 @@ enum class FFT_Sign : int { No=0, Forward=1, Backward=2 };
 *  @brief type of transform
 *  @todo  avoid global scope 
 **/
-enum class FFT_Type : int {DUMMY=0, XYZ=1, X=2, XY=4, Y=16, AA=32, FIELDS=64, X_FIELDS=128, Y_FIELDS=256, Y_PSF=512, Y_NL=1024};
+enum class FFT_Type : int {DUMMY=0, XYZ=1, X=2, XY=4, Y=16, AA=32, FIELDS=64, X_FIELDS=128, Y_FIELDS=256, Y_PSF=512, Y_NL=1024, X_FIELDS_STACK=2048, X_MOMENTS=4096};
 
 
 /** 
@@ -141,8 +141,37 @@ class FFTSolver : public IfaceGKC {
    **/
    CComplex *kXIn, *kXOut;
 
+   /**
+   *  @brief Input array for the (backward) transform of the gyro-averaged fields
+   *
+   *  Holds the fields for all species and magnetic moments as 
+   *  kXInStack[Nq][NsLD][NmLD][NzLD][Nky][X_NkxL], which are transformed
+   *  back together using FFT_Type::X_FIELDS_STACK.
+   *
+   **/
+   CComplex *kXInStack;
+
+   /**
+   *  @brief Output/input arrays for the batched transform of the velocity moments
+   *
+   *  The moments of all species kXOutMoments[8][NsLD][NzLD][Nky][X_NkxL] are transformed 
+   *  together using FFT_Type::X_MOMENTS (forward to kXOutMoments, backward from kXInMoments).
+   *
+   **/
+   CComplex *kXOutMoments, *kXInMoments;
+
    static int X_NkxL;
    int K1xLlD, K1xLuD;
+  
+   /**
+   *  @brief active spectral band for Y-transforms in the non-linearity
+   *
+   *  Input modes \f$ k_y \ge \f$ Y_NkyIn are assumed to be zero and are not gathered, 
+   *  output modes \f$ k_y \ge \f$ Y_NkyOut are dropped (set to zero). By default
+   *  only the Nyquist mode is excluded, set by FFTSolver.Y.NkyIn/NkyOut.
+   *
+   **/
+   int Y_NkyIn, Y_NkyOut;
    int K1yLlD, K1yLuD;
    // @}
 
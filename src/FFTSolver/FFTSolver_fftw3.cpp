@@ -11,6 +11,16 @@
 
 #include <fftw3-mpi.h>
 
+#ifdef GKC_PARALLEL_OPENMP
+#include <omp.h>
+#endif
+
+#include <sys/stat.h>
+#include <cstdlib>
+#include <stdint.h>
+#include <sstream>
+#include <algorithm>
+
 
 #include "FFTSolver/FFTSolver_fftw3.h"
 
@@ -21,10 +31,34 @@
 fftw_plan plan_YForward_Field, plan_YBackward_Field, 
           plan_YForward_PSF, plan_YBackward_PSF,
           plan_YForward_NL , plan_YBackward_NL;
-fftw_plan plan_XForward_Fields, plan_XBackward_Fields;
+fftw_plan plan_XForward_Fields, plan_XBackward_Fields, plan_XBackward_Stack;
+fftw_plan plan_XForward_Moments, plan_XBackward_Moments;
 fftw_plan plan_FieldTranspose_1, plan_FieldTranspose_2;
 fftw_plan plan_AA_YForward, plan_AA_YBackward;
 
+#ifdef GKC_PARALLEL_OPENMP
+/**
+*   @brief allows a nested parallel region during its lifetime
+*
+*   X-transforms are executed inside "omp single" of our global OpenMP region,
+*   thus a threaded plan opens a nested team, while the other threads wait at
+*   the barrier of the single construct. Nesting is enabled only during execution
+*   and the previous setting is restored afterwards.
+*
+**/
+class NestedParallel
+{
+  int levels; ///< previous maximum number of active levels
+   
+ public:
+  NestedParallel(const bool enable) : levels(omp_get_max_active_levels())
+  {
+    if(enable) omp_set_max_active_levels(std::max(levels, omp_get_active_level() + 1));
+  };
+ ~NestedParallel() { omp_set_max_active_levels(levels); };
+};
+#endif
+
 
 // from http://agentzlerich.blogspot.jp/2010/01/using-fftw-for-in-place-matrix.html
 // any license issues ? 
@@ -49,26 +83,40 @@ if(1==1) {
     else if (plan == "Exhaustive" ) perf_flag = FFTW_EXHAUSTIVE;
     else    (-1, DMESG("Config file : FFTSolver.FFTW3.Plan"));
 
-    // Setup wisdom
-    wisdom = setup->get("FFTSolver.FFTW3.Wisdom", "");
-    if     (wisdom == "System") fftw_import_system_wisdom();
-    else if(wisdom != ""      ) fftw_import_wisdom_from_filename(wisdom.c_str());
-
     const int nfields = plasma->nfields;
 
-#ifdef PARALLEL_OPENMP
-    //this should use our global OpenMPI threads
-    //fftw_init_threads();
-    //fftw_plan_with_nthreads(parallel->numThreads);
+    // number of threads used for the X-transform (which is called from a single thread)
+    numThreads_X = setup->get("FFTSolver.FFTW3.Threads", parallel->numThreads);
+
+#ifdef GKC_PARALLEL_OPENMP
+    // threads have to be initialized before fftw_mpi_init (hybrid MPI/OpenMP)
+    check(fftw_init_threads() == 0 ? -1 : 0, DMESG("fftw_init_threads failed"));
+
+    // waiting threads of our team would compete with the nested fftw team (see NestedParallel)
+    const char *env_wait = std::getenv("OMP_WAIT_POLICY");
+    const bool  passive  = (env_wait != nullptr) && ((std::string(env_wait) == "passive") || (std::string(env_wait) == "PASSIVE"));
+
+    if((numThreads_X > 1) && (parallel->numThreads > 1) && !passive) 
+      parallel->print("FFTSolver : threaded X-transform (FFTSolver.FFTW3.Threads > 1) requires OMP_WAIT_POLICY=passive");
 #endif
 
 #ifdef GKC_PARALLEL_MPI
     fftw_mpi_init();
 #endif
     
-#ifdef PARALLEL_OPENMP
-//    fftw_plan_with_nthreads(parallel->numThreads);
+#ifdef GKC_PARALLEL_OPENMP
+    fftw_plan_with_nthreads(numThreads_X);
 #endif
+
+    // Setup wisdom (after fftw_mpi_init, as it is broadcasted to all processes)
+    wisdom = setup->get("FFTSolver.FFTW3.Wisdom", "Auto");
+    if(wisdom == "Auto") {
+
+      // default cache is $HOME/.gkc/wisdom (no cache if no home directory is set)
+      const char *home = std::getenv("HOME");
+      wisdom = getWisdomFileName(setup->get("FFTSolver.FFTW3.WisdomPath", (home != nullptr) ? std::string(home) + "/.gkc/wisdom" : ""));
+    }
+    importWisdom();
     ////////////////////// Set for X-direction (FFT Poisson solver) /////////// 
     
     // set and check bounds 
@@ -78,15 +126,20 @@ if(1==1) {
       
     FFTSolver::X_NkxL = X_NkxL;
       
-    // Pre-factor of 3 for safety (is required otherwise we get crash, but why ?)
-    int numAlloc = 3 * std::max(NxLD, (int) X_numElements) * NkyLD * NzLD * nfields;
+    // if X is not decomposed, we can transform directly in our [Nq][Nz][Ny][Nx] layout
+    // using the serial (strided) interface, and thus avoid the transposes required by fftw3-mpi
+    X_isLocal = (parallel->decomposition[DIR_X] == 1);
+
+    const long numAlloc = getNumAlloc(X_numElements, nfields);
     // allocate arrays 
     data_X_kIn      = (CComplex *) fftw_alloc_complex(numAlloc);
     data_X_kOut     = (CComplex *) fftw_alloc_complex(numAlloc);
     data_X_rOut     = (CComplex *) fftw_alloc_complex(numAlloc);
     data_X_rIn      = (CComplex *) fftw_alloc_complex(numAlloc);
-    data_X_Transp_1 = (CComplex *) fftw_alloc_complex(numAlloc);
-    data_X_Transp_2 = (CComplex *) fftw_alloc_complex(numAlloc);
+    data_X_Transp_1 = X_isLocal ? nullptr : (CComplex *) fftw_alloc_complex(numAlloc);
+    data_X_Transp_2 = X_isLocal ? nullptr : (CComplex *) fftw_alloc_complex(numAlloc);
+    
+    nct::allocate::record("FFTW buffers", getBufferBytes(X_isLocal, numAlloc, 0, 0));
       
     check((NxLD != X_NxLD) ? -1 : 0, DMESG("Bounds to not align")); 
          
@@ -105,14 +158,89 @@ if(1==1) {
     //           MPI_Comm comm, int sign, unsigned flags);
     
     long numTrans = NkyLD * NzLD * nfields;
-     
-    plan_XForward_Fields  = fftw_mpi_plan_many_dft(1, &X_Nx, numTrans, NxLD, X_NkxL, (fftw_complex *) data_X_rIn, (fftw_complex *) data_X_kOut , parallel->Comm[DIR_X], FFTW_FORWARD , perf_flag);
-    plan_XBackward_Fields = fftw_mpi_plan_many_dft(1, &X_Nx, numTrans, NxLD, X_NkxL, (fftw_complex *) data_X_kIn, (fftw_complex *) data_X_rOut, parallel->Comm[DIR_X], FFTW_BACKWARD, perf_flag);
+    
+    // Note : for the serial interface, input/output arrays are passed at execution (new-array execute),
+    //        thus we cannot assume same alignment as planned arrays 
+    int X_Nx_i = Nx, X_NkxL_i = X_NkxL;
+
+    if(X_isLocal) {
+      
+      //                                                   howmany                     in        stride dist                      out      stride  dist
+      plan_XForward_Fields  = fftw_plan_many_dft(1, &X_Nx_i, numTrans, (fftw_complex *) data_X_rIn, NULL, 1, NxLD    , (fftw_complex *) data_X_kOut, NULL, 1, X_NkxL_i, FFTW_FORWARD , perf_flag | FFTW_UNALIGNED);
+      plan_XBackward_Fields = fftw_plan_many_dft(1, &X_Nx_i, numTrans, (fftw_complex *) data_X_kIn, NULL, 1, X_NkxL_i, (fftw_complex *) data_X_rOut, NULL, 1, NxLD    , FFTW_BACKWARD, perf_flag | FFTW_UNALIGNED);
+    }
+    else {
+    
+      plan_XForward_Fields  = fftw_mpi_plan_many_dft(1, &X_Nx, numTrans, NxLD, X_NkxL, (fftw_complex *) data_X_rIn, (fftw_complex *) data_X_kOut , parallel->Comm[DIR_X], FFTW_FORWARD , perf_flag);
+      plan_XBackward_Fields = fftw_mpi_plan_many_dft(1, &X_Nx, numTrans, NxLD, X_NkxL, (fftw_complex *) data_X_kIn, (fftw_complex *) data_X_rOut, parallel->Comm[DIR_X], FFTW_BACKWARD, perf_flag);
+    }
 
     // check plans (maybe null if linked e.g. to MKL)
     if(plan_XForward_Fields  == NULL) check(-1, DMESG("Plan not supported"));
     if(plan_XBackward_Fields == NULL) check(-1, DMESG("Plan not supported"));
 
+    // Batched backward transform for gyro-averaged fields of all species and magnetic moments
+    {
+      long numTransStack = numTrans * NsLD * NmLD, X_NxLD_S, X_NxLlD_S, X_NkxL_S, X_NkxLlD_S;
+      
+      const long numAllocStack = fftw_mpi_local_size_many_1d(Nx, numTransStack, parallel->Comm[DIR_X], FFTW_BACKWARD, 0, 
+                                                             &X_NxLD_S, &X_NxLlD_S, &X_NkxL_S, &X_NkxLlD_S);
+      
+      data_X_kIn_Stack      = (CComplex *) fftw_alloc_complex(numAllocStack);
+      data_X_Stack_Transp_1 = X_isLocal ? nullptr : (CComplex *) fftw_alloc_complex(numAllocStack);
+      data_X_Stack_Transp_2 = (CComplex *) fftw_alloc_complex(numAllocStack);
+      
+      nct::allocate::record("FFTW buffers", getBufferBytes(X_isLocal, 0, numAllocStack, 0));
+
+      kXInStack = nct::allocate(nct::Range(0,plasma->nfields), nct::Range(NsLlD,NsLD), nct::Range(NmLlD,NmLD), 
+                                nct::Range(NzLlD,NzLD), nct::Range(NkyLlD, NkyLD), nct::Range(X_NkxLlD, X_NkxL)).zero(data_X_kIn_Stack);
+      
+      if(X_isLocal) plan_XBackward_Stack = fftw_plan_many_dft(1, &X_Nx_i, numTransStack, (fftw_complex *) data_X_kIn_Stack     , NULL, 1, X_NkxL_i, 
+                                                              (fftw_complex *) data_X_Stack_Transp_2, NULL, 1, NxLD, FFTW_BACKWARD, perf_flag | FFTW_UNALIGNED);
+      else          plan_XBackward_Stack = fftw_mpi_plan_many_dft(1, &X_Nx, numTransStack, NxLD, X_NkxL, (fftw_complex *) data_X_Stack_Transp_1, 
+                                                                  (fftw_complex *) data_X_Stack_Transp_2, parallel->Comm[DIR_X], FFTW_BACKWARD, perf_flag);
+    
+      if(plan_XBackward_Stack == NULL) check(-1, DMESG("Plan not supported"));
+    }
+    
+    // Batched forward/backward transform for the 8 velocity moments of all species (see Moments)
+    {
+      long numTransMom = NkyLD * NzLD * 8 * NsLD, X_NxLD_M, X_NxLlD_M, X_NkxL_M, X_NkxLlD_M;
+      
+      const long numAllocMom = fftw_mpi_local_size_many_1d(Nx, numTransMom, parallel->Comm[DIR_X], FFTW_FORWARD, 0, 
+                                                           &X_NxLD_M, &X_NxLlD_M, &X_NkxL_M, &X_NkxLlD_M);
+      
+      data_X_kOut_Mom     = (CComplex *) fftw_alloc_complex(numAllocMom);
+      data_X_kIn_Mom      = (CComplex *) fftw_alloc_complex(numAllocMom);
+      data_X_Mom_Transp_1 = X_isLocal ? nullptr : (CComplex *) fftw_alloc_complex(numAllocMom);
+      data_X_Mom_Transp_2 = X_isLocal ? nullptr : (CComplex *) fftw_alloc_complex(numAllocMom);
+      
+      nct::allocate::record("FFTW buffers", getBufferBytes(X_isLocal, 0, 0, numAllocMom));
+
+      nct::allocate Array_kXMom = nct::allocate(nct::Range(0,8), nct::Range(NsLlD,NsLD), nct::Range(NzLlD,NzLD), 
+                                                nct::Range(NkyLlD, NkyLD), nct::Range(X_NkxLlD, X_NkxL));
+      kXOutMoments = Array_kXMom.zero(data_X_kOut_Mom);
+      kXInMoments  = Array_kXMom.zero(data_X_kIn_Mom );
+
+      // real-space arrays are passed at execution (buffers are used as placeholders for planning)
+      if(X_isLocal) {
+
+        plan_XForward_Moments  = fftw_plan_many_dft(1, &X_Nx_i, numTransMom, (fftw_complex *) data_X_kIn_Mom , NULL, 1, NxLD    , 
+                                                    (fftw_complex *) data_X_kOut_Mom, NULL, 1, X_NkxL_i, FFTW_FORWARD , perf_flag | FFTW_UNALIGNED);
+        plan_XBackward_Moments = fftw_plan_many_dft(1, &X_Nx_i, numTransMom, (fftw_complex *) data_X_kIn_Mom , NULL, 1, X_NkxL_i, 
+                                                    (fftw_complex *) data_X_kOut_Mom, NULL, 1, NxLD    , FFTW_BACKWARD, perf_flag | FFTW_UNALIGNED);
+      }
+      else {
+
+        plan_XForward_Moments  = fftw_mpi_plan_many_dft(1, &X_Nx, numTransMom, NxLD, X_NkxL, (fftw_complex *) data_X_Mom_Transp_1, 
+                                                        (fftw_complex *) data_X_Mom_Transp_2, parallel->Comm[DIR_X], FFTW_FORWARD , perf_flag);
+        plan_XBackward_Moments = fftw_mpi_plan_many_dft(1, &X_Nx, numTransMom, NxLD, X_NkxL, (fftw_complex *) data_X_Mom_Transp_1, 
+                                                        (fftw_complex *) data_X_Mom_Transp_2, parallel->Comm[DIR_X], FFTW_BACKWARD, perf_flag);
+      }
+    
+      if((plan_XForward_Moments == NULL) || (plan_XBackward_Moments == NULL)) check(-1, DMESG("Plan not supported"));
+    }
+
     // Fields have to be continuous in howmanyfields, and thus we have to transpose the array (use in-place) 
     // add factor of 2 because we deal with complex numbers not real numbers
     // plan_FieldTranspose = plan_transpose('R', 2* NxLD, 2 * NkyLD * NzLD * nfields, (double *) kXOut.data(), (double *) kXOut.data());
@@ -168,6 +296,12 @@ if(1==1) {
     // to use algorithms that do not destroy the input, at the expense of worse performance; for multi-dimensional
     // c2r transforms, however, no input-preserving algorithms are implemented and the planner will return NULL if one is requested.
     
+    // Y-transforms are executed concurrently by each thread on its private (aligned) buffers
+    // using the new-array execute functions, which is thread-safe. Thus plans are single-threaded.
+#ifdef GKC_PARALLEL_OPENMP
+    fftw_plan_with_nthreads(1);
+#endif
+
     doubleAA   rY_BD4[NyLD ][NxLB+4]; CComplexAA kY_BD4[NkyLD][NxLB+4];
     plan_YBackward_Field = fftw_plan_many_dft_c2r(1, &NyLD, NxLB+4, (fftw_complex *) kY_BD4, NULL, NxLB+4, 1, (double *) rY_BD4, NULL, NxLB+4, 1, perf_flag);
     
@@ -193,8 +327,8 @@ if(1==1) {
 
     setNormalizationConstants();
    
-    // export it again (only by root job ?!)
-    if(wisdom != "") fftw_export_wisdom_to_filename(wisdom.c_str());
+    // export it again (including new plans from all processes)
+    exportWisdom();
    
   }
 
@@ -204,10 +338,18 @@ if(1==1) {
 /// too much crap here ..... :(
 void FFTSolver_fftw3::solve(const FFT_Type type, const FFT_Sign direction, void *in, void *out) 
 {
+#ifdef GKC_PARALLEL_OPENMP
+  const bool isX = (type == FFT_Type::X_FIELDS) || (type == FFT_Type::X_FIELDS_STACK) || (type == FFT_Type::X_MOMENTS);
+  NestedParallel nested(isX && (numThreads_X > 1));
+#endif
   
   if(type == FFT_Type::X_FIELDS) {
              
-    if     (direction == FFT_Sign::Forward )  {
+    // no transpose required if X is not decomposed 
+    if     ((direction == FFT_Sign::Forward ) && X_isLocal) fftw_execute_dft(plan_XForward_Fields , (fftw_complex *) in        , (fftw_complex *) data_X_kOut);
+    else if((direction == FFT_Sign::Backward) && X_isLocal) fftw_execute_dft(plan_XBackward_Fields, (fftw_complex *) data_X_kIn, (fftw_complex *) in         );
+
+    else if(direction == FFT_Sign::Forward )  {
     
       // fftw3-mpi many transform requires specific input (thus we have to transpose our data)
       transpose(NxLD, NkyLD, NzLD, plasma->nfields, (A4zz) ((CComplex *) in), (A4zz) ((CComplex *) data_X_Transp_1));                
@@ -227,6 +369,45 @@ void FFTSolver_fftw3::solve(const FFT_Type type, const FFT_Sign direction, void
      
   }  
   
+  else if(type == FFT_Type::X_FIELDS_STACK) {
+    
+    // the stack [Nq][NsLD][NmLD] is treated as a single (large) field index 
+    const int numStack = plasma->nfields * NsLD * NmLD;
+
+    if((direction == FFT_Sign::Backward) && X_isLocal) fftw_execute_dft(plan_XBackward_Stack, (fftw_complex *) data_X_kIn_Stack, (fftw_complex *) in);
+
+    else if(direction == FFT_Sign::Backward) {
+    
+      transpose(X_NkxL, NkyLD, NzLD, numStack, (A4zz) ((CComplex *) data_X_kIn_Stack), (A4zz) ((CComplex *) data_X_Stack_Transp_1));                
+      fftw_mpi_execute_dft(plan_XBackward_Stack, (fftw_complex *) data_X_Stack_Transp_1, (fftw_complex *) data_X_Stack_Transp_2); 
+      transpose_rev(NxLD, NkyLD, NzLD, numStack, (A4zz) ((CComplex *) data_X_Stack_Transp_2), (A4zz) ((CComplex *) in));                
+    }
+    else   check(-1, DMESG("No such FFT direction"));
+  }
+  
+  else if(type == FFT_Type::X_MOMENTS) {
+    
+    // the moments [8][NsLD] are treated as a single (large) field index 
+    const int numMom = 8 * NsLD;
+
+    if     ((direction == FFT_Sign::Forward ) && X_isLocal) fftw_execute_dft(plan_XForward_Moments , (fftw_complex *) in            , (fftw_complex *) data_X_kOut_Mom);
+    else if((direction == FFT_Sign::Backward) && X_isLocal) fftw_execute_dft(plan_XBackward_Moments, (fftw_complex *) data_X_kIn_Mom, (fftw_complex *) in             );
+
+    else if(direction == FFT_Sign::Forward ) {
+    
+      transpose(NxLD, NkyLD, NzLD, numMom, (A4zz) ((CComplex *) in), (A4zz) data_X_Mom_Transp_1);                
+      fftw_mpi_execute_dft(plan_XForward_Moments, (fftw_complex *) data_X_Mom_Transp_1, (fftw_complex *) data_X_Mom_Transp_2); 
+      transpose_rev(X_NkxL, NkyLD, NzLD, numMom, (A4zz) data_X_Mom_Transp_2, (A4zz) data_X_kOut_Mom);                
+    }
+    else if(direction == FFT_Sign::Backward) {
+    
+      transpose(X_NkxL, NkyLD, NzLD, numMom, (A4zz) data_X_kIn_Mom, (A4zz) data_X_Mom_Transp_1);                
+      fftw_mpi_execute_dft(plan_XBackward_Moments, (fftw_complex *) data_X_Mom_Transp_1, (fftw_complex *) data_X_Mom_Transp_2); 
+      transpose_rev(NxLD, NkyLD, NzLD, numMom, (A4zz) data_X_Mom_Transp_2, (A4zz) ((CComplex *) in));                
+    }
+    else   check(-1, DMESG("No such FFT direction"));
+  }
+  
    // These are speed critical (move above x-transformation)
    else if(type == FFT_Type::Y_FIELDS ) {
             
@@ -273,6 +454,9 @@ FFTSolver_fftw3::~FFTSolver_fftw3()
     //  release fftw-3  
         fftw_destroy_plan(plan_XForward_Fields);
        fftw_destroy_plan(plan_XBackward_Fields);
+       fftw_destroy_plan(plan_XBackward_Stack);
+       fftw_destroy_plan(plan_XForward_Moments);
+       fftw_destroy_plan(plan_XBackward_Moments);
        
        fftw_destroy_plan(plan_YForward_Field);
        fftw_destroy_plan(plan_YBackward_Field);
@@ -283,8 +467,8 @@ FFTSolver_fftw3::~FFTSolver_fftw3()
     //fftw_destroy_plan(plan_FieldTranspose_1);
     //fftw_destroy_plan(plan_FieldTranspose_2);
 
-#ifdef PARALLEL_OPENMP
-//    fftw_cleanup_threads();
+#ifdef GKC_PARALLEL_OPENMP
+    fftw_cleanup_threads();
 #endif
 
     fftw_free(data_X_rOut);
@@ -294,8 +478,69 @@ FFTSolver_fftw3::~FFTSolver_fftw3()
     
     fftw_free(data_X_Transp_1);
     fftw_free(data_X_Transp_2);
+    
+    fftw_free(data_X_kIn_Stack);
+    fftw_free(data_X_Stack_Transp_1);
+    fftw_free(data_X_Stack_Transp_2);
+    
+    fftw_free(data_X_kOut_Mom);
+    fftw_free(data_X_kIn_Mom );
+    fftw_free(data_X_Mom_Transp_1);
+    fftw_free(data_X_Mom_Transp_2);
+}
+
+
+std::string FFTSolver_fftw3::getWisdomFileName(const std::string dir)
+{
+  // no directory given, thus we do not cache
+  if(dir == "") return "";
+
+  // plans depend on global and local grid size, decomposition, threads and fftw version
+  std::stringstream key;
+  key << Nx << " " << Nky << " " << NxLB << " " << NxLD << " " << NkyLD << " " << NzLD << " " 
+      << NsLD << " " << NmLD << " " << plasma->nfields << " " << numThreads_X << " " << plan << " " << fftw_version;
+  for(int d = DIR_X; d <= DIR_S; d++) key << " " << parallel->decomposition[d];
+
+  // FNV-1a (64 bit), as std::hash is implementation defined and may differ between builds
+  uint64_t fnv = 14695981039346656037ULL;
+  for(const char c : key.str()) { fnv ^= (unsigned char) c; fnv *= 1099511628211ULL; }
+
+  std::stringstream hash; 
+  hash << std::hex << std::setw(16) << std::setfill('0') << fnv;
+
+  // create directory including parents if not existent (only root process writes the file)
+  if(parallel->myRank == 0) {
+    for(size_t pos = dir.find('/', 1); pos != std::string::npos; pos = dir.find('/', pos + 1)) mkdir(dir.substr(0, pos).c_str(), 0755);
+    mkdir(dir.c_str(), 0755);
+  }
+
+  return dir + "/" + hash.str() + ".wis";
+}
+
+void FFTSolver_fftw3::importWisdom()
+{
+  if     (wisdom == "System") fftw_import_system_wisdom();
+  else if(wisdom == ""      ) return;
+  // only root process reads file, (missing file is fine, as it is created after planning)
+  else if(parallel->myRank == 0) fftw_import_wisdom_from_filename(wisdom.c_str());
+
+#ifdef GKC_PARALLEL_MPI
+  fftw_mpi_broadcast_wisdom(parallel->Comm[DIR_ALL]);
+#endif
 }
 
+void FFTSolver_fftw3::exportWisdom()
+{
+  if((wisdom == "") || (wisdom == "System")) return;
+
+#ifdef GKC_PARALLEL_MPI
+  // collect plans from all processes (local sizes may differ)
+  fftw_mpi_gather_wisdom(parallel->Comm[DIR_ALL]);
+#endif
+
+  if(parallel->myRank == 0) 
+    if(fftw_export_wisdom_to_filename(wisdom.c_str()) == 0) std::cout << "Warning : failed to export fftw wisdom to " << wisdom << std::endl;
+}
 
 // Nice, no X-parallelization required !!
 void FFTSolver_fftw3::multiply(const CComplex A[NkyLD][NxLD], const CComplex B[NkyLD][NxLD],
@@ -394,7 +639,8 @@ void FFTSolver_fftw3::printOn(std::ostream &output) const
 {
 
   output << "FFTSolver  |  using fftw-3 interface for (" << std::string(fftw_version) << ")" << std::endl;
-  output << "           |  Plan : " << (plan == "" ? "None" : plan) << " Wisdom : " << ((wisdom=="") ? "None" : wisdom) << std::endl;
+  output << "           |  Plan : " << (plan == "" ? "None" : plan) << " Wisdom : " << ((wisdom=="") ? "None" : wisdom) 
+         << " Threads (X) : " << numThreads_X << std::endl;
          
 }
 
@@ -21,6 +21,8 @@
 
 #include "FFTSolver/FFTSolver.h"
 
+#include <algorithm>
+
 
 /**
 *   @brief Interface for the fftw Fast-Fourier Solver
@@ -44,6 +46,20 @@ class FFTSolver_fftw3 : public FFTSolver
 
    CComplex *data_X_kOut, *data_X_kIn;
 
+   /**
+   *   Arrays for batched (backward) transform over species and magnetic moment
+   **/ 
+   CComplex *data_X_kIn_Stack, *data_X_Stack_Transp_1, *data_X_Stack_Transp_2;
+
+   /**
+   *   Arrays for batched transform of the (8) velocity moments of all species
+   **/ 
+   CComplex *data_X_kOut_Mom, *data_X_kIn_Mom, *data_X_Mom_Transp_1, *data_X_Mom_Transp_2;
+
+   bool X_isLocal;  ///< X not decomposed, transform directly without transposing
+
+   int numThreads_X; ///< number of fftw threads used for X-transform
+
    int AA_NkyLD,    ///< use for anti-alias multiplication
        AA_NyLD;     ///< use for anti-alias multiplication
 
@@ -52,13 +68,38 @@ class FFTSolver_fftw3 : public FFTSolver
    void transpose_rev(int Nx, int Ny, int Nz, int Nq, 
                       CComplex In[Nx][Ny][Nz][Nq], CComplex OutT[Nq][Nz][Ny][Nx]);
 
+   /**
+   *   @brief file name of automatic wisdom cache
+   *
+   *   Wisdom is stored in <dir>/<hash>.wis, where the (FNV-1a) hash is calculated 
+   *   from grid size, decomposition, threads, plan and the fftw version.
+   *
+   *   @param dir directory of cache (FFTSolver.FFTW3.WisdomPath), created if
+   *              not existent, no cache if empty
+   *
+   **/
+   std::string getWisdomFileName(const std::string dir);
+
+   /// root process imports wisdom and broadcasts it to all processes
+   void importWisdom();
+   
+   /// gathers wisdom from all processes and root process exports it
+   void exportWisdom();
+
   public:
    /**
    *   @brief the contstructor
    *
    *   Setup accepts
-   *     FFTW.Plan   = { "Measure", "Estimate", "Exhausting" }
-   *     FFTW.Wisdom = { "", "link to file" }
+   *     FFTSolver.FFTW3.Plan       = { "Measure", "Estimate", "Patient", "Exhaustive" }
+   *     FFTSolver.FFTW3.Wisdom     = { "Auto", "System", "", "link to file" }
+   *     FFTSolver.FFTW3.WisdomPath = directory of wisdom cache used for "Auto" (default : $HOME/.gkc/wisdom)
+   *     FFTSolver.FFTW3.Threads    = number of threads for X-transform (default : OpenMP threads)
+   *
+   *   The X-transform is executed inside "omp single" and opens a nested team 
+   *   of FFTSolver.FFTW3.Threads threads, while the remaining threads of our
+   *   team wait at the barrier. Thus OMP_WAIT_POLICY=passive is required, 
+   *   otherwise waiting threads spin and compete with the fftw threads.
    *
    *     @todo allow file link to plan 
    *
@@ -84,6 +125,33 @@ class FFTSolver_fftw3 : public FFTSolver
    
 
 
+   /**
+   *  @brief number of elements of each buffer of the (single) X-transform
+   *
+   *  @param X_numElements  local size as returned by fftw_mpi_local_size_1d
+   *  @param nfields        number of fields
+   *
+   **/
+   static long getNumAlloc(const long X_numElements, const int nfields)
+   {
+     // Pre-factor of 3 for safety (is required otherwise we get crash, but why ?)
+     return 3 * std::max((long) NxLD, X_numElements) * NkyLD * NzLD * nfields;
+   };
+
+   /**
+   *  @brief memory of X-transform buffers (transpose buffers only if X is decomposed)
+   *
+   *  @param X_isLocal      X is not decomposed
+   *  @param numAlloc       elements of each buffer of the X-transform (see getNumAlloc)
+   *  @param numAllocStack  elements of each buffer of the batched field transform
+   *  @param numAllocMom    elements of each buffer of the batched moment transform
+   *
+   **/
+   static size_t getBufferBytes(const bool X_isLocal, const long numAlloc, const long numAllocStack, const long numAllocMom)
+   {
+     return ((X_isLocal ? 4 : 6) * numAlloc + (X_isLocal ? 2 : 3) * numAllocStack + (X_isLocal ? 2 : 4) * numAllocMom) * sizeof(CComplex);
+   };
+
    virtual void printOn(std::ostream &output) const;
 
    virtual void initData(FileIO *fileIO) {};
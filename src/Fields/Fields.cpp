@@ -18,7 +18,7 @@
 int GC2, GC4;
 
 Fields::Fields(Setup *setup, Grid *_grid, Parallel *_parallel, FileIO *fileIO, Geometry *_geo)  : 
-grid(_grid), parallel(_parallel), geo(_geo), solveEq(0)
+grid(_grid), parallel(_parallel), geo(_geo), solveEq(0), Mom(nullptr)
 
 {
   GC2 = 2; GC4 = 4, Nq=plasma->nfields;
@@ -29,12 +29,12 @@ grid(_grid), parallel(_parallel), geo(_geo), solveEq(0)
   solveEq |=  ((Nq >= 3) && (setup->get("Init.FixedBp" , ".0") == ".0")) ? Field::IBp  : 0;
 
   // Allocate variables for calculating source terms and field terms
-  ArrayField  = nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD , grid->RzLB, grid->RkyLD, nct::Range(NxLlD-4, NxLD+8))(&Field);
-  ArrayField0 = nct::allocate(nct::Range(0,Nq), grid->RzLD, grid->RkyLD, grid->RxLD)(&Q, &Qm, &Field0);
+  ArrayField  = nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD , grid->RzLB, grid->RkyLD, nct::Range(NxLlD-4, NxLD+8)).purpose("Fields")(&Field);
+  ArrayField0 = nct::allocate(nct::Range(0,Nq), grid->RzLD, grid->RkyLD, grid->RxLD).purpose("Sources")(&Q, &Qm, &Field0);
 
   // Allocate boundary conditions, allocate Send/Recv buffers, note we have 4 ghost cells for X, 0 for Y
-  ArrayBoundX = nct::allocate(nct::Range(0,    4 * Nky * NzLD * NmLD * NsLD * Nq))(&SendXl, &SendXu, &RecvXl, &RecvXu);
-  ArrayBoundZ = nct::allocate(nct::Range(0, NxLD * Nky *    2 * NmLD * NsLD * Nq))(&SendZl, &SendZu, &RecvZl, &RecvZu);
+  ArrayBoundX = nct::allocate(nct::Range(0,    4 * Nky * NzLD * NmLD * NsLD * Nq)).purpose("Boundary buffers")(&SendXl, &SendXu, &RecvXl, &RecvXu);
+  ArrayBoundZ = nct::allocate(nct::Range(0, NxLD * Nky *    2 * NmLD * NsLD * Nq)).purpose("Boundary buffers")(&SendZl, &SendZu, &RecvZl, &RecvZu);
        
   // should equal 1/2. To avoid cancellation error due to numerical errors, calculate it numerically, see Dannert[2] 
   Yeb = (1./sqrt(M_PI) * __sec_reduce_add(pow2(V[NvLlD:NvLD]) * exp(-pow2(V[NvLlD:NvLD]))) * dv) * geo->eps_hat * plasma->beta; 
@@ -47,15 +47,16 @@ Fields::~Fields()
   closeData() ;
 }
 
-void Fields::solve(const CComplex *f0, CComplex *f, Timing timing)
+void Fields::solve(const double *f0, PComplex *f, Timing timing)
 {
+  // re-calculate pre-calculated terms if parameters changed (e.g. Ly)
+  updateTables();
+
   // calculate source terms  Q (Q is overwritten in the first iteration )
   for(int s = NsLlD, loop=0; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++, loop++) {
 
-    // calculate drift-kinetic terms (use OpenMP schedule(static) to allow cache fusion)
-    if(solveEq & Field::Iphi) calculateChargeDensity               ((A6zz) f0, (A6zz) f, (A4zz) Field0, m, s);
-    if(solveEq & Field::IAp ) calculateParallelCurrentDensity      ((A6zz) f0, (A6zz) f, (A4zz) Field0, m, s);
-    if(solveEq & Field::IBp ) calculatePerpendicularCurrentDensity ((A6zz) f0, (A6zz) f, (A4zz) Field0, m, s);
+    // calculate drift-kinetic terms (and requested velocity moments) in a single sweep over f
+    calculateSourceMoments((A5rr) f0, (A6pp) f, (A4zz) Field0, (A5zz) Mom, m, s);
     #pragma omp barrier
 
     // Integrate over velocity space through different CPU's
@@ -81,6 +82,13 @@ void Fields::solve(const CComplex *f0, CComplex *f, Timing timing)
     }
   } } // for m, s
 
+  // integrate velocity moments over v and mu, which are required by all processes (e.g. LenardBernstein)
+  if(Mom != nullptr) {
+    
+    #pragma omp single
+    parallel->reduce(ArrayMoments.data(Mom), Op::sum, DIR_VM, ArrayMoments.getNum()); 
+  }
+
   /////////////////////////////// Solve for the corresponding fields ////////////////////////////////
   // Note :  Fields are only solved by root nodes  (X=0, V=0, S=0), Gyro-averaging is done for (V=0)
   if(parallel->Coord[DIR_V] == 0) {
@@ -98,25 +106,7 @@ void Fields::solve(const CComplex *f0, CComplex *f, Timing timing)
     parallel->bcast(ArrayField0.data(Field0), DIR_MS, ArrayField0.getNum());
 
     // Gyro-averaging procedure for each species and magnetic moment ( guiding-coord -> gyro-coord )
-    // OPTIM : We can skip forward transform after first call
-    for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) {
-
-      // Fields has a complicated stride, thus cannot be easily used in FFTSolver.
-      // Use temporary Qm, and copy to Fields afterwards.
-
-      // forward-transformation from drift-center -> gyro-center 
-      gyroAverage((A4zz) Field0, (A4zz) Qm, m, s, true);
-
-      // Copy result in temporary array to field
-      [=] (CComplex Qm[Nq][NzLD][Nky][NxLD], CComplex Field[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]) 
-      { 
-        #pragma omp for collapse(2)
-        for(int z = NzLlD; z <= NzLuD; z++) {  for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) {
-
-          Field[:][s][m][z][y_k][NxLlD:NxLD] = Qm[:][z][y_k][NxLlD:NxLD];
-        } }
-      } ((A4zz) Qm, (A6zz) Field);
-    } } // s, m
+    gyroAverageFields((A4zz) Field0, (A6zz) Field);
  
     #pragma omp single
     updateBoundary();
@@ -127,56 +117,105 @@ void Fields::solve(const CComplex *f0, CComplex *f, Timing timing)
   parallel->bcast(ArrayField.data(Field), DIR_V, ArrayField.getNum());
 }
 
-void Fields::calculateChargeDensity(const CComplex f0      [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                    const CComplex f       [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                          CComplex Field0          [Nq][NzLD][Nky][NxLD]      ,
-                                    const int m, const int s) 
+void Fields::requestMoments()
 {
-  
-  // In case of a full-f simulation the Maxwellian is subtracted
-  const double pqnB_dvdm = M_PI * species[s].q * species[s].n0 * plasma->B0 * dv * grid->dm[m] ;
+  if(Mom == nullptr) ArrayMoments = nct::allocate(nct::Range(0,3), grid->RsLD, grid->RzLD, grid->RkyLD, grid->RxLD).purpose("Moments")(&Mom);
+}
 
-  #pragma omp for collapse(2) nowait, schedule(static)
-  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
-  for(int x = NxLlD; x <= NxLuD; x++) {
+void Fields::gyroAverageMoments(CComplex In [NmLD][8][NsLD][NzLD][Nky][NxLD],
+                                CComplex Out          [8][NsLD][NzLD][Nky][NxLD])
+{
+  // Note : Q (source terms) is only required during solve, thus used as output buffer,
+  //        as gyroAverage may be executed (redundantly) by all threads, it is not done in-place
+  [=] (CComplex In [NmLD][8][NsLD][NzLD][Nky][NxLD], CComplex Out[8][NsLD][NzLD][Nky][NxLD],
+       CComplex Qm [Nq]             [NzLD][Nky][NxLD], CComplex Q  [Nq]       [NzLD][Nky][NxLD])
+  {
+    #pragma omp single
+    Out[:][:][:][:][:] = 0.;
 
-    Field0[Field::phi][z][y_k][x] = ( __sec_reduce_add(f [s][m][z][y_k][x][NvLlD:NvLD]) 
-                  - (plasma->global ? __sec_reduce_add(f0[s][m][z][y_k][x][NvLlD:NvLD]) : 0)) * pqnB_dvdm;
-     
-  } } } // z, y_k, x
+    for(int n = 0; n < 8; n++) { for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) {
+    
+      // gyroAverage requires size [Nq][...], thus surplus fields have to be zero
+      #pragma omp single
+      {
+        Qm[0:Nq][NzLlD:NzLD][:][NxLlD:NxLD] = 0.;
+        Qm[0   ][NzLlD:NzLD][:][NxLlD:NxLD] = In[m-NmLlD][n][s-NsLlD][:][:][:];
+      }
+
+      // backward-transformation from gyro-center -> drift-center
+      gyroAverage(Qm, Q, m, s, false);
+      #pragma omp barrier
+
+      #pragma omp single
+      Out[n][s-NsLlD][:][:][:] += Q[0][NzLlD:NzLD][:][NxLlD:NxLD];
+
+    } } } // n, s, m
+  } ((A6zz) In, (A5zz) Out, (A4zz) Qm, (A4zz) Q);
 }
 
-void Fields::calculateParallelCurrentDensity(const CComplex f0    [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                             const CComplex f     [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                                   CComplex Field0        [Nq][NzLD][Nky][NxLD]      ,
-                                             const int m, const int s                                  ) 
+void Fields::gyroAverageFields(const CComplex Field0[Nq][NzLD][Nky][NxLD],
+                                     CComplex Field [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4])
 {
-  const double qa_dvdm = species[s].q * species[s].n0  * species[s].alpha * M_PI * dv * grid->dm[m] ;
-   
-  #pragma omp for collapse(2) nowait, schedule(static)
-  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
-  for(int x = NxLlD; x <= NxLuD; x++) {
+  for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) {
 
-    Field0[Field::Ap][z][y_k][x] = -__sec_reduce_add(V[NvLlD:NvLD] * f[s][m][z][y_k][x][NvLlD:NvLD]) * qa_dvdm;
+    // Fields has a complicated stride, thus cannot be easily used in FFTSolver.
+    // Use temporary Qm, and copy to Fields afterwards.
 
-  } } } // z, y_k, x
+    // forward-transformation from drift-center -> gyro-center 
+    gyroAverage(Field0, (A4zz) Qm, m, s, true);
+
+    // Copy result in temporary array to field
+    [=] (CComplex Qm[Nq][NzLD][Nky][NxLD], CComplex Field_[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]) 
+    { 
+      #pragma omp for collapse(2)
+      for(int z = NzLlD; z <= NzLuD; z++) {  for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) {
+
+        Field_[:][s][m][z][y_k][NxLlD:NxLD] = Qm[:][z][y_k][NxLlD:NxLD];
+      } }
+    } ((A4zz) Qm, (A6zz) Field);
+  } } // s, m
 }
 
-// Note : Did not checked correctness of this function
-void Fields::calculatePerpendicularCurrentDensity(const CComplex f0     [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                                  const CComplex f      [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                                  CComplex       Field0         [Nq][NzLD][Nky][NxLD]      ,
-                                                  const int m, const int s                                    ) 
+void Fields::calculateSourceMoments(const double   f0      [NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                    const PComplex f       [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
+                                          CComplex Field0          [Nq][NzLD][Nky][NxLD]      ,
+                                          CComplex Mom           [3][NsLD][NzLD][Nky][NxLD]   ,
+                                    const int m, const int s) 
 {
-   
-  const double qan_dvdm = - species[s].q * species[s].alpha * plasma->B0 * M_PI * dv * grid->dm[m] ;
-   
+  const bool usePhi = solveEq & Field::Iphi;
+  const bool useAp  = solveEq & Field::IAp ;
+  const bool useBp  = solveEq & Field::IBp ;
+  const bool useMom = (Mom != nullptr);
+  
+  // In case of a full-f simulation the Maxwellian is subtracted
+  const double pqnB_dvdm = M_PI * species[s].q * species[s].n0 * plasma->B0 * dv * grid->dm[m] ;
+  const double qa_dvdm   = species[s].q * species[s].n0  * species[s].alpha * M_PI * dv * grid->dm[m] ;
+  const double qan_dvdm  = - species[s].q * species[s].alpha * plasma->B0 * M_PI * dv * grid->dm[m] ;
+  const double dvdm      = dv * grid->dm[m];
+
+  // use OpenMP schedule(static) to allow cache fusion
   #pragma omp for collapse(2) nowait, schedule(static)
   for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
   for(int x = NxLlD; x <= NxLuD; x++) {
 
-    Field0[Field::Bp][z][y_k][x] =  M[m] * __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD]) * qan_dvdm;
-            
+    // moments of a single v-line, which is kept in cache for all reductions
+    const CComplex n_ =                        __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD]);
+    const CComplex j_ = (useAp || useMom)    ? __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD] * V[NvLlD:NvLD]      ) : 0.;
+    const CComplex e_ =  useMom              ? __sec_reduce_add(f[s][m][z][y_k][x][NvLlD:NvLD] * pow2(V[NvLlD:NvLD])) : 0.;
+
+    if(usePhi) Field0[Field::phi][z][y_k][x] = ( n_ - (plasma->global ? __sec_reduce_add(f0[s][m][z][x][NvLlD:NvLD]) : 0)) * pqnB_dvdm;
+    if(useAp ) Field0[Field::Ap ][z][y_k][x] = - j_ * qa_dvdm;
+    if(useBp ) Field0[Field::Bp ][z][y_k][x] =  M[m] * n_ * qan_dvdm;  // Note : Did not checked correctness 
+    
+    // integrate over mu, first m overwrites
+    if(useMom) {
+
+      const CComplex dn = n_ * dvdm, dP = j_ * dvdm, dE = (e_ + 2. * M[m] * n_) * dvdm;
+
+      if(m == NmLlD) { Mom[VMoment::n][s][z][y_k][x]  = dn; Mom[VMoment::P][s][z][y_k][x]  = dP; Mom[VMoment::E][s][z][y_k][x]  = dE; }
+      else           { Mom[VMoment::n][s][z][y_k][x] += dn; Mom[VMoment::P][s][z][y_k][x] += dP; Mom[VMoment::E][s][z][y_k][x] += dE; }
+    }
+     
   } } } // z, y_k, x
 }
 
@@ -246,17 +285,19 @@ void Fields::initData(Setup *setup, FileIO *fileIO)
      
   hid_t fieldsGroup = fileIO->newGroup("Fields");
      
-  FA_fields      = new FileAttr("Phi" , fieldsGroup, fileIO->file, 5, dim, mdim, cdim, moff, cBdim, off, write, fileIO->complex_tid);
+  FA_fields      = new FileAttr("Phi" , fieldsGroup, fileIO->file, 5, dim, mdim, cdim, moff, cBdim, off, write, fileIO->complex_tid, true, true);
   FA_fieldsTime  = fileIO->newTiming(fieldsGroup);
         
   H5Gclose(fieldsGroup);
       
   dataOutputFields = Timing(setup->get("DataOutput.Fields.Step", -1), setup->get("DataOutput.Fields.Time", -1.));
+  taskFields       = fileIO->scheduler->add("Fields", dataOutputFields);
 }   
 
 void Fields::writeData(const Timing &timing, const double dt) 
 {
-  if (timing.check(dataOutputFields, dt)       )   {
+  if (taskFields->check(timing, dt)       )   {
+    Scheduler::Scope cost(taskFields);
     FA_fields->write(ArrayField0.data(Field0));
     FA_fieldsTime->write(&timing);
       
@@ -46,6 +46,19 @@ namespace Field { const int  phi =0 , ///< electric field
                 };
 //namespace Field { constexpr const int phi=1, Ap=2, Bp=3, Bpp=4; }
 
+/**
+*  @brief defined offset to access velocity moments which are calculated
+*         together with the source terms (see Fields::calculateSourceMoments)
+*
+*         \f$ n = \int f_{1\sigma}                                     dv_\parallel d\mu \f$
+*         \f$ P = \int f_{1\sigma} v_\parallel                         dv_\parallel d\mu \f$
+*         \f$ E = \int f_{1\sigma} \left( v_\parallel^2 + 2 \mu \right) dv_\parallel d\mu \f$
+**/
+namespace VMoment { const int n = 0, ///< density
+                              P = 1, ///< parallel momentum
+                              E = 2; ///< kinetic energy
+                  };
+
 /**
 *
 *  @brief Calculate sources and interface to field solvers
@@ -151,74 +164,36 @@ class Fields : public IfaceGKC {
   virtual ~Fields();
 
   /** 
-  *  @brief Calculates the charge density for \f$ \rho(x,y_k,z; \mu, \sigma) \f$.
+  *  @brief Calculates the source terms for \f$ (\mu, \sigma) \f$ in a single sweep over \f$ v_\parallel \f$
   *
-  *  The charge density is calculated according to
+  *  The charge density, parallel and perpendicular current density are calculated according to
   *
-  *  \f[   
-  *   \rho(x,y_k,z;\mu,\sigma) = q_\sigma \int_{v_\parallel}  g_{1\sigma}(x,y_k,z,v_\parallel,\mu,\sigma) \textrm{d}alpha 
-  *  \f]
-  *  with \f$\textrm{d}\alpha=n_{0;\sigma} \pi \hat{B}_0 \textrm{d}v_\parallel \textrm{d}\mu\f$.
+  *  \f{align}{   
+  *   \rho(x,y_k,z;\mu,\sigma)       &= q_\sigma \int_{v_\parallel}  g_{1\sigma}(x,y_k,z,v_\parallel,\mu,\sigma) \textrm{d}\alpha \\
+  *   j_\parallel(x,y_k,z;\mu,\sigma) &= q_\sigma \int_{v_\parallel} v_\parallel g_{1\sigma}(x,y_k,z;\mu,\sigma) \textrm{d}\beta \\
+  *   j_\perp(x,y_k,z;\mu,\sigma)     &= q_\sigma \int_{v_\parallel} \mu g_{1\sigma} \textrm{d}\gamma 
+  *  \f}
+  *  with \f$\textrm{d}\alpha=n_{0;\sigma} \pi \hat{B}_0 \textrm{d}v_\parallel \textrm{d}\mu\f$,
+  *  \f$\textrm{d}\beta=n_{0;\sigma} \alpha_\sigma \pi \hat{B}_0 \textrm{d}v_\parallel \textrm{d}\mu\f$ and
+  *  \f$\textrm{d}\gamma=n_{0;\sigma} \alpha_\sigma \pi B_0 \textrm{d}v_\parallel \textrm{d}\mu \f$ (see @cite DannertPhD).
+  *
+  *  If requested (see requestMoments), the velocity moments \f$ (n, P, E) \f$ integrated 
+  *  over \f$ \mu \f$ are accumulated in Mom from the same sweep. This avoids a separate
+  *  pass over the phase space by e.g. the collision operator.
   *
-  *  @param f0 The Maxwellian phase-space background distribution
-  *  @param f  Current phase-space distribution
-  *  @param m  index for perpendicular velocity \f$ \mu = M[m]  \f$
-  *  @param s  index for species
+  *  @param f0  The Maxwellian phase-space background distribution
+  *  @param f   Current phase-space distribution
+  *  @param Mom velocity moments (accumulated over m)
+  *  @param m   index for perpendicular velocity \f$ \mu = M[m]  \f$
+  *  @param s   index for species
   *
   **/
-  void calculateChargeDensity(const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                              const CComplex f  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
+  void calculateSourceMoments(const double   f0 [NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                              const PComplex f  [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
                               CComplex Field0           [Nq][NzLD][Nky][NxLD]      ,
+                              CComplex Mom            [3][NsLD][NzLD][Nky][NxLD]   ,
                               const int m, const int s) ;
 
-  /**
-  * @brief Calculates the parallel current density \f$ j_\parallel(x,y_k,z;\mu,\sigma) \f$.
-  *
-  * The parallel current density is calculated according to 
-  *
-  *  \f[   
-  *       j_\parallel(x,y_k,z;\mu,\sigma) = q_\sigma \int_{v_\parallel} g_{1\sigma}(x,y_k,z;\mu,\sigma) \textrm{d}\beta
-  *  \f]
-  *  with \f$\textrm{d}\beta=n_{0;\sigma} \alpha_\sigma \pi \hat{B}_0 \textrm{d}v_\parallel \textrm{d}\mu\f$.
-  * 
-  *  Reference : 
-  *  
-  *  @param f0 The Maxwellian phase-space background distribution
-  *  @param f  Current phase-space distribution
-  *  @param m  index for perpendicular velocity \f$ \mu = M[m]\f$
-  *  @param s  index for species
-  *
-  **/
-  void calculateParallelCurrentDensity(const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                       const CComplex f  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                       CComplex Field0           [Nq][NzLD][Nky][NxLD]      ,
-                                       const int m, const int s) ;
-
-  /**
-  *  Calculates the perpendicular current density \f$ j_\perp(x,y_k,z;\mu,\sigma) \f$
-  *
-  *  Calculates
-  *  \f[
-  *      j_\perp(x,y_k,z;\mu,\sigma) = q_\sigma \int_{v_\parallel=-\infty}^\infty \mu g_{1\sigma} \textrm{d}\gamma
-  *  \f]
-  *  with \f$\textrm{d}\gamma=n_{0;\sigma} \alpha_\sigma \pi B_0 \textrm{d}v_\parallel \textrm{d}\mu \f$.
-  *
-  *  See Equation ?? @cite DannertPhD
-  *
-  *  @note Defined virtual, as there may be more effective implementations
-  *
-  *  @param f0 The Maxwellian phase-space background distribution
-  *  @param f  Current phase-space distribution
-  *  @param Q  Current phase-space distribution
-  *  @param m  index for perpendicular velocity \f$ \mu = M[m]\f$
-  *  @param s  index for species
-  *
-  **/
-  virtual void  calculatePerpendicularCurrentDensity(const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                                     const CComplex f  [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                                     CComplex Field0           [Nq][NzLD][Nky][NxLD]      ,
-                                                     const int m, const int s); 
-
   /**
   *  @brief Solves the field equation from the source terms.
   *  
@@ -306,6 +281,37 @@ class Fields : public IfaceGKC {
                            const int m, const int s, const bool forward, const bool stack=false) = 0;
   
    
+  /**
+  *  @brief performs the (forward) gyro-averaging of the fields for all species
+  *         and magnetic moments and stores them in Field
+  *
+  *  Default implementation calls gyroAverage for each \f$ (\mu, \sigma) \f$. 
+  *  Solvers may override it to share work between the gyro-averages
+  *  (e.g. transform the fields only once).
+  *
+  *  @param Field0  fields in drift-coordinates
+  *  @param Field   gyro-averaged fields (only domain is set, not boundaries)
+  *
+  **/
+  virtual void gyroAverageFields(const CComplex Field0[Nq][NzLD][Nky][NxLD],
+                                       CComplex Field [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]);
+  
+  /**
+  *  @brief performs the (backward) gyro-averaging of the velocity moments
+  *         and sums them over the magnetic moments
+  *
+  *  \f[ Out_{n\sigma} = \sum_\mu \left< In_{\mu n \sigma} \right> \f]
+  *
+  *  Default implementation calls gyroAverage for each \f$ (n, \mu, \sigma) \f$. 
+  *  Has to be called by all threads of a parallel region (or outside of any).
+  *
+  *  @param In   moments in gyro-coordinates (not offset, overwritten)
+  *  @param Out  gyro-averaged moments summed over μ (not offset)
+  *
+  **/
+  virtual void gyroAverageMoments(CComplex In [NmLD][8][NsLD][NzLD][Nky][NxLD],
+                                  CComplex Out          [8][NsLD][NzLD][Nky][NxLD]);
+   
   /**
   *    @brief performed double gyro-average over Maxwellian background
   *
@@ -356,8 +362,19 @@ class Fields : public IfaceGKC {
   CComplex *Field;
 
    
-  nct::allocate ArrayField0, ///< Array allocator for Field0 variable
-                ArrayField ; ///< Array allocator for Field variable
+  /**
+  *  @brief velocity moments of the phase space function integrated over \f$ \mu \f$
+  *
+  *  Access using Mom[VMoment::n][s][z][y_k][x]. Only allocated if requested by
+  *  requestMoments (e.g. by the moment conserving collision operator), otherwise 
+  *  nullptr. Moments are summed over all processes in v and \f$ \mu \f$ (DIR_VM).
+  *
+  **/
+  CComplex *Mom;
+   
+  nct::allocate ArrayField0 , ///< Array allocator for Field0 variable
+                ArrayField  , ///< Array allocator for Field variable
+                ArrayMoments; ///< Array allocator for Mom variable
    
   /**
   * 
@@ -382,7 +399,7 @@ class Fields : public IfaceGKC {
   *
   *
   **/
-  void solve(const CComplex *f0, CComplex  *f, Timing timing=0);
+  void solve(const double *f0, PComplex  *f, Timing timing=0);
 
 
   /**
@@ -393,6 +410,23 @@ class Fields : public IfaceGKC {
   **/
   int getSolveEq() const { return solveEq; };
 
+  /**
+  *  @brief update pre-calculated terms of the field solver if required
+  *
+  *  Called at the beginning of solve by all threads. 
+  *
+  **/
+  virtual void updateTables() {};
+
+  /**
+  *  @brief request calculation of the velocity moments Mom
+  *
+  *  Moments are calculated together with the source terms in solve, thus
+  *  the same phase space function is used.
+  *
+  **/
+  void requestMoments();
+
 
   /**
   *  @brief write field values put to data file
@@ -429,6 +463,7 @@ class Fields : public IfaceGKC {
   *
   **/
   Timing dataOutputFields;
+  Scheduler::Task *taskFields; ///< Scheduled output of fields
 
 
   /**
@@ -21,6 +21,16 @@ FieldsFFT::FieldsFFT(Setup *setup, Grid *grid, Parallel *parallel, FileIO *fileI
    
   screenNyquist = setup->get("Fields.screenNyquist", 1);
 
+  ArrayStack = nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD, grid->RzLD, grid->RkyLD, grid->RxLD).purpose("Field stack")(&FieldStack);
+
+  // pre-calculate special functions terms for field equations and gyro-averaging
+  const nct::Range RkxL(fft->K1xLlD, FFTSolver::X_NkxL);
+
+  ArrayTables = nct::allocate(grid->RzLD, grid->RkyLD, RkxL).purpose("Field tables")(&tab_k2G0, &tab_Ap, &tab_qnBD, &tab_TnBBD);
+  ArrayKernel = nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD, grid->RzLD, grid->RkyLD, RkxL).purpose("Gyro-average kernel")(&gyroKernel);
+
+  resetTables();
+  updateTables();
 } 
 
 
@@ -55,9 +65,74 @@ void FieldsFFT::solveFieldEquations(const CComplex Q     [Nq][NzLD][Nky][NxLD],
   fft->solve(FFT_Type::X_FIELDS, FFT_Sign::Backward, ArrayField0.data((CComplex *) Field0));
 }
 
+void FieldsFFT::resetTables()
+{
+  tablesLy = -1.;
+}
+
+void FieldsFFT::updateTables()
+{
+  // all threads need to evaluate the condition before tables are updated
+  const bool isOutdated = (tablesLy != Ly);
+  #pragma omp barrier
+
+  if(isOutdated) {
+    
+    #pragma omp single
+    {
+      calculateTables((A3rr) tab_k2G0, (A3rr) tab_Ap, (A3rr) tab_qnBD, (A3rr) tab_TnBBD, (A6rr) gyroKernel);
+      tablesLy = Ly;
+    }
+  }
+}
+
+void FieldsFFT::calculateTables(double k2G0[NzLD][Nky][FFTSolver::X_NkxL], double Ap  [NzLD][Nky][FFTSolver::X_NkxL],
+                                double qnBD[NzLD][Nky][FFTSolver::X_NkxL], double TnBBD[NzLD][Nky][FFTSolver::X_NkxL],
+                                double kernel[Nq][NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL])
+{
+  // create jump table between 0 <= q <= 2 for averaging function
+  double (*avrg_func[])(double) = { j0, j0, SFL::i1 };
+  
+  for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
+  for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
+
+    const double k2_p = fft->k2_p(x_k,y_k,z);
+
+    // Terms for Poisson, Ampere and B-parallel equation 
+    k2G0 [z][y_k][x_k] = plasma->debye2 * k2_p + sum_qqnT_1mG0(k2_p);
+    Ap   [z][y_k][x_k] = - k2_p - Yeb * sum_sa2qG0(k2_p);
+    qnBD [z][y_k][x_k] = - sum_qnB_Delta(k2_p);
+    TnBBD[z][y_k][x_k] = (Nq >= 3) ? 2./plasma->beta - sum_2TnBB_Delta(k2_p) : 0.;
+  
+    // Remove Nyquist frequency as it may leads to numerical errors (from stencils)
+    const bool isNyquist = ((y_k == Nky-1) || (x_k == Nx/2)) && screenNyquist;
+
+    // Gyro-averaging kernel (including FFT normalization)
+    for(int s = NsLlD; s <= NsLuD; s++) { 
+      
+      // get thermal gyro-radius^2 of species and lambda =  2 x b 
+      const double rho_t2  = species[s].T0 * species[s].m / (pow2(species[s].q) * plasma->B0); 
+      
+      for(int m = NmLlD; m <= NmLuD; m++) { for(int q = 0; q < Nq; q++) {
+
+        const double lambda2 = 2. * M[m] * rho_t2;
+    
+        double K = 1.;
+    
+        if     (species[s].gyroModel == "Gyro"  ) K = isNyquist ? 0. : avrg_func[q](sqrt(lambda2 * k2_p));
+        else if(species[s].gyroModel == "Gyro-1") K = isNyquist ? 0. : exp(-k2_p * rho_t2);
+
+        kernel[q][s][m][z][y_k][x_k] = K / fft->Norm_X;
+    } } }
+  
+  } } } // z, y_k, x_k
+}
+
 void FieldsFFT::solvePoissonEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_NkxL],
                                      CComplex kXIn [Nq][NzLD][Nky][FFTSolver::X_NkxL])
 {
+  double (*tab_k2G0_)[Nky][FFTSolver::X_NkxL] = (A3rr) tab_k2G0;
+
   // Calculate flux-surface averaging  Note : how to deal with FFT normalization here ?
   CComplex phi_yz[Nx]; phi_yz[:] = 0.;
 
@@ -77,12 +152,9 @@ void FieldsFFT::solvePoissonEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_
     // Set kx=0/ky=0 component to zero (gauge freedom)
     if((x_k == 0) && (y_k == 0)) { kXIn[Field::phi][z][y_k][x_k] = 0.e0 ; continue; }
    
-    // BUG (Optimize) : need to vectorize this one 
-    const double k2_p = fft->k2_p(x_k,y_k,z);
-         
     // adiabatic term \adiab ( \phi - <\phi>_{yz}), we shift flux averaging term <\phi>_{yz}
     // to rhs due to FFT normalization, flux-surface averaging only affects zonal flow itself.
-    const double lhs    = plasma->debye2 * k2_p + sum_qqnT_1mG0(k2_p) + adiab;
+    const double lhs    = tab_k2G0_[z][y_k][x_k] + adiab;
     const CComplex rhs  = kXOut[Field::phi][z][y_k][x_k] + (y_k == 0 ? adiab*phi_yz[x_k]: 0.); 
     
     kXIn[Field::phi][z][y_k][x_k] = rhs/(lhs * fft->Norm_X);
@@ -96,6 +168,8 @@ void FieldsFFT::solveAmpereEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_N
                                     CComplex kXIn [Nq][NzLD][Nky][FFTSolver::X_NkxL])
 
 {
+  double (*tab_Ap_)[Nky][FFTSolver::X_NkxL] = (A3rr) tab_Ap;
+
   #pragma omp for collapse(2) nowait
   for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
     
@@ -103,10 +177,8 @@ void FieldsFFT::solveAmpereEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_N
  
     // Set kx=0/ky=0 component to zero (gauge freedom)
     if((x_k == 0) && (y_k == 0)) { kXIn[Field::Ap][z][y_k][x_k] = 0.e0 ; continue; }
-          
-    const double k2_p = fft->k2_p(x_k,y_k,z);
-           
-    const double   lhs =  - k2_p - Yeb * sum_sa2qG0(k2_p);
+
+    const double   lhs =  tab_Ap_[z][y_k][x_k];
     const CComplex rhs =  kXOut[Field::Ap][z][y_k][x_k]; 
      
     kXIn[Field::Ap][z][y_k][x_k] = rhs/(lhs * fft->Norm_X);
@@ -117,6 +189,9 @@ void FieldsFFT::solveAmpereEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_N
 void FieldsFFT::solveBParallelEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_NkxL],
                                        CComplex kXIn [Nq][NzLD][Nky][FFTSolver::X_NkxL])
 {
+  double (*tab_k2G0_ )[Nky][FFTSolver::X_NkxL] = (A3rr) tab_k2G0 ;
+  double (*tab_qnBD_ )[Nky][FFTSolver::X_NkxL] = (A3rr) tab_qnBD ;
+  double (*tab_TnBBD_)[Nky][FFTSolver::X_NkxL] = (A3rr) tab_TnBBD;
 
   const double adiab = species[0].n0 * pow2(species[0].q)/species[0].T0;
     
@@ -126,12 +201,10 @@ void FieldsFFT::solveBParallelEquation(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::
   simd_for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
  
     if((x_k == 0) && (y_k == 0)) { kXIn[Field::phi][z][y_k][x_k] = 0.; continue; }
-         
-    const double k2_p = fft->k2_p(x_k,y_k,z);
 
-    const double C_1 = plasma->debye2 * k2_p + sum_qqnT_1mG0(k2_p) + adiab;
-    const double C_2 = - sum_qnB_Delta(k2_p);
-    const double C_3 = 2./plasma->beta - sum_2TnBB_Delta(k2_p);
+    const double C_1 = tab_k2G0_ [z][y_k][x_k] + adiab;
+    const double C_2 = tab_qnBD_ [z][y_k][x_k];
+    const double C_3 = tab_TnBBD_[z][y_k][x_k];
           
     const CComplex M_00 = kXOut[Field::phi][z][y_k][x_k];
     const CComplex M_01 = kXOut[Field::Bp ][z][y_k][x_k];
@@ -148,6 +221,8 @@ void FieldsFFT::calcFluxSurfAvrg(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_NkxL
 {
   const double _kw_Nz = 1./((double) Nz)  ; // Number of poloidal points in real space
 
+  double (*tab_k2G0_)[Nky][FFTSolver::X_NkxL] = (A3rr) tab_k2G0;
+
   // Note : In FFT the ky=0 components carries the offset over y (integrated value), thus
   //        by dividing through the number of points we get the averaged valued
   for(int z = NzLlD; z <= NzLuD; z++) { if(NkyLlD == 0) { 
@@ -157,9 +232,7 @@ void FieldsFFT::calcFluxSurfAvrg(CComplex kXOut[Nq][NzLD][Nky][FFTSolver::X_NkxL
     if(x_k == 0) { phi_yz[x_k] = 0.e0 ; continue; }
          
     // k_y < A >_y = 0 (thus no need to include)
-    const double k2_p  = fft->k2_p(x_k, 0, z);
-     
-    const double lhs   = plasma->debye2 * k2_p + sum_qqnT_1mG0(k2_p);
+    const double lhs   = tab_k2G0_[z][0][x_k];
     // A(x_k, 0) is the sum over y, thus A(x_k, 0)/Ny is the average 
     const CComplex rhs =  kXOut[Field::phi][z][0][x_k] * _kw_Nz;
      
@@ -220,12 +293,8 @@ void FieldsFFT::gyroFull(const CComplex In   [Nq][NzLD][Nky][NxLD             ],
   #pragma omp single
   fft->solve(FFT_Type::X_FIELDS, FFT_Sign::Forward, stack ? (void *) &In[0][0][0][0] : (void *) &In[0][NzLlD][0][NxLlD]);
 
-  // get thermal gyro-radius^2 of species and lambda =  2 x b 
-  const double rho_t2  = species[s].T0 * species[s].m / (pow2(species[s].q) * plasma->B0); 
-  const double lambda2 = 2. * M[m] * rho_t2;
-    
-  // create jump table between 0 <= q <= 2 for averaging function
-  double (*avrg_func[])(double) = { j0, j0, SFL::i1 };
+  // pre-calculated kernel (includes FFT normalization and Nyquist screening)
+  double (*kernel)[NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL] = (A6rr) gyroKernel;
 
   // solve for all fields at once
   for(int q = 0; q < Nq; q++) {
@@ -233,15 +302,9 @@ void FieldsFFT::gyroFull(const CComplex In   [Nq][NzLD][Nky][NxLD             ],
   #pragma omp for collapse(2)
   for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
 
-  for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
-    
-    const double k2_p = fft->k2_p(x_k,y_k,z);
+  simd_for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
     
-    // Remove Nyquist frequency as it may leads to numerical errors (from stencils)
-    if(( (y_k == Nky-1) || (x_k == Nx/2)) && screenNyquist) { kXIn[Field::phi][z][y_k][x_k]  = 0.; continue; }
-          
-    kXIn[q][z][y_k][x_k] = kXOut[q][z][y_k][x_k]/fft->Norm_X * avrg_func[q](sqrt(lambda2 * k2_p));
-   
+    kXIn[q][z][y_k][x_k] = kXOut[q][z][y_k][x_k] * kernel[q][s][m][z][y_k][x_k];
 
   } } }
 
@@ -267,21 +330,17 @@ void FieldsFFT::gyroFirst(const CComplex In   [Nq][NzLD][Nky][NxLD],
   #pragma omp single
   fft->solve(FFT_Type::X_FIELDS, FFT_Sign::Forward, (void *) &In[0][NzLlD][NkyLlD][NxLlD]);
            
+  // pre-calculated kernel (independent of field and magnetic moment for Gyro-1)
+  double (*kernel)[NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL] = (A6rr) gyroKernel;
+
   // solve for all fields at once
   for(int q = 0; q < Nq; q++) {
 
-  // get thermal gyro-radius^2 of species and lambda =  2 x b 
-  const double rho_t2 = species[s].T0 * species[s].m / (pow2(species[s].q) * plasma->B0); 
-
   #pragma omp for collapse(2)
   for(int z=NzLlD; z<=NzLuD;z++) { for(int y_k=NkyLlD; y_k<= NkyLuD;y_k++) {  simd_for(int x_k=fft->K1xLlD; x_k<= fft->K1xLuD;x_k++) {
     
     // perform gyro-average in Fourier space for rho/phi field
-    const double k2p_rhoth2 = fft->k2_p(x_k, y_k, z) * rho_t2;
-          
-    kXIn[q][z][y_k][x_k] = kXOut[q][z][y_k][x_k]/fft->Norm_X * exp(-k2p_rhoth2); 
-
-    if(((y_k == Nky-1) || (x_k == Nx/2)) && screenNyquist) kXIn[q][z][y_k][x_k]  = 0.;
+    kXIn[q][z][y_k][x_k] = kXOut[q][z][y_k][x_k] * kernel[0][s][NmLlD][z][y_k][x_k]; 
             
   } } }
    
@@ -306,6 +365,89 @@ void FieldsFFT::gyroAverage(const CComplex In [Nq][NzLD][Nky][NxLD], CComplex Ou
   
 }
 
+void FieldsFFT::gyroAverageFields(const CComplex Field0[Nq][NzLD][Nky][NxLD],
+                                        CComplex Field [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4])
+{
+  // transform fields only once to Fourier space
+  #pragma omp single
+  fft->solve(FFT_Type::X_FIELDS, FFT_Sign::Forward, (void *) &Field0[0][NzLlD][0][NxLlD]);
+  
+  [=](const CComplex kXOut    [Nq]            [NzLD][Nky][FFTSolver::X_NkxL],
+            CComplex kXIn     [Nq][NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL],
+            CComplex FieldS   [Nq][NsLD][NmLD][NzLD][Nky][NxLD             ],
+            CComplex Field_   [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4           ],
+      const double   kernel   [Nq][NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL])
+  {
+    // apply pre-calculated averaging kernel for all species and magnetic moments
+    #pragma omp for collapse(3)
+    for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) { for(int z = NzLlD; z <= NzLuD; z++) {
+      
+    for(int q = 0; q < Nq; q++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
+    
+    simd_for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
+  
+      kXIn[q][s][m][z][y_k][x_k] = kXOut[q][z][y_k][x_k] * kernel[q][s][m][z][y_k][x_k];
+  
+    } } } // q, y_k, x_k
+  
+    } } } // s, m, z
+  
+    // transform back all (s,m) at once
+    #pragma omp single
+    fft->solve(FFT_Type::X_FIELDS_STACK, FFT_Sign::Backward, &FieldS[0][NsLlD][NmLlD][NzLlD][0][NxLlD]);
+  
+    // Copy result to field
+    #pragma omp for collapse(3)
+    for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) { for(int z = NzLlD; z <= NzLuD; z++) {
+  
+      Field_[0:Nq][s][m][z][NkyLlD:Nky][NxLlD:NxLD] = FieldS[0:Nq][s][m][z][NkyLlD:Nky][NxLlD:NxLD];
+
+    } } }
+  
+  } ((A4zz) fft->kXOut, (A6zz) fft->kXInStack, (A6zz) FieldStack, (A6zz) Field, (A6rr) gyroKernel);
+}
+
+void FieldsFFT::gyroAverageMoments(CComplex In [NmLD][8][NsLD][NzLD][Nky][NxLD],
+                                   CComplex Out          [8][NsLD][NzLD][Nky][NxLD])
+{
+  [=](      CComplex In    [NmLD][8][NsLD][NzLD][Nky][NxLD],
+            CComplex Out             [8][NsLD][NzLD][Nky][NxLD],
+      const CComplex kXOut           [8][NsLD][NzLD][Nky][FFTSolver::X_NkxL],
+            CComplex kXIn            [8][NsLD][NzLD][Nky][FFTSolver::X_NkxL],
+      const double   kernel[Nq][NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL])
+  {
+    // backward average is the identity for drift-kinetic and Gyro-1 species (FFT normalization only)
+    bool isGyro[NsLD];
+    for(int s = NsLlD; s <= NsLuD; s++) isGyro[s-NsLlD] = (species[s].gyroModel == "Gyro");
+
+    for(int m = NmLlD; m <= NmLuD; m++) {
+  
+      // transform moments of all species at once
+      #pragma omp single
+      fft->solve(FFT_Type::X_MOMENTS, FFT_Sign::Forward, (void *) &In[m-NmLlD][0][0][0][0][0]);
+  
+      // apply averaging kernel and sum over magnetic moments in Fourier space
+      #pragma omp for collapse(3)
+      for(int n = 0; n < 8; n++) { for(int s = NsLlD; s <= NsLuD; s++) { for(int z = NzLlD; z <= NzLuD; z++) {
+  
+      for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { simd_for(int x_k = fft->K1xLlD; x_k <= fft->K1xLuD; x_k++) {
+  
+        const CComplex kMom = kXOut[n][s][z][y_k][x_k] * (isGyro[s-NsLlD] ? kernel[0][s][m][z][y_k][x_k] : 1./fft->Norm_X);
+  
+        kXIn[n][s][z][y_k][x_k] = (m == NmLlD) ? kMom : kXIn[n][s][z][y_k][x_k] + kMom;
+  
+      } } // y_k, x_k
+  
+      } } } // n, s, z
+    } // m
+  
+    // transform back all moments at once
+    #pragma omp single
+    fft->solve(FFT_Type::X_MOMENTS, FFT_Sign::Backward, &Out[0][0][0][0][0]);
+  
+  } ((A6zz) In, (A5zz) Out, (A5zz) fft->kXOutMoments, (A5zz) fft->kXInMoments, (A6rr) gyroKernel);
+}
+
 void FieldsFFT::printOn(std::ostream &output) const
 {
   Fields::printOn(output);
@@ -333,6 +475,8 @@ void FieldsFFT::getFieldEnergy(double& phiEnergy, double& ApEnergy, double& BpEn
       if(species[0].doGyro) calcFluxSurfAvrg(kXOut, phi_yz);
       const double adiab = species[0].n0 * pow2(species[0].q)/species[0].T0;
       
+      double (*tab_k2G0_)[Nky][FFTSolver::X_NkxL] = (A3rr) tab_k2G0;
+      
       //#pragma omp parallel for, collapse(2), reduce(+,phiEnergy,ApEnergy,BpEnergy)
       for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) { 
       
@@ -341,7 +485,7 @@ void FieldsFFT::getFieldEnergy(double& phiEnergy, double& ApEnergy, double& BpEn
         const double k2_p = fft->k2_p(x_k,y_k,z);
 
         // when to do FFT normalization ?
-        if(Nq >= 1) phiEnergy += (plasma->debye2*k2_p + sum_qqnT_1mG0(k2_p)) * pow2(cabs(kXOut[Field::phi][z][y_k][x_k]))/fft->Norm_X +
+        if(Nq >= 1) phiEnergy += tab_k2G0_[z][y_k][x_k] * pow2(cabs(kXOut[Field::phi][z][y_k][x_k]))/fft->Norm_X +
                                  // adiabatic contributions (with correction from flux-surface averaging)
                                  adiab * pow2(cabs(kXOut[Field::phi][z][y_k][x_k] - (y_k == 0 ? phi_yz[x_k] : 0.)))/fft->Norm_X ;
 
@@ -78,6 +78,10 @@ class FieldsFFT : public Fields {
    
   FFTSolver *fft;
 
+  CComplex *FieldStack; ///< gyro-averaged fields for all (s,m) as [Nq][NsLD][NmLD][NzLD][Nky][NxLD]
+   
+  nct::allocate ArrayStack; ///< Array allocator for FieldStack 
+
   /** 
   *  @brief Calculation of the flux-surface average
   *
@@ -107,6 +111,42 @@ class FieldsFFT : public Fields {
   **/
   bool screenNyquist;
 
+  /**
+  *   @brief Pre-calculated (special function) terms for the field solver
+  *
+  *   These terms depend only on geometry, species, \f$ \mu \f$ and  
+  *   wavenumber and are thus calculated once (see calculateTables).
+  *   Access as e.g. tab_k2G0[z][y_k][x_k] and gyroKernel[q][s][m][z][y_k][x_k].
+  *
+  **/
+  double *tab_k2G0  , ///< \f$ \lambda_D^2 k_\perp^2 + \sum_\sigma \frac{q_\sigma^2 n_{0\sigma}}{T_{0\sigma}} (1 - \Gamma_0) \f$
+         *tab_Ap    , ///< \f$ - k_\perp^2 - Y_{eb} \sum_\sigma \sigma_\sigma \alpha_\sigma^2 q_\sigma \Gamma_0 \f$ 
+         *tab_qnBD  , ///< \f$ - \frac{1}{B_0} \sum_\sigma q_\sigma n_{0\sigma} \Delta \f$
+         *tab_TnBBD , ///< \f$ \frac{2}{\beta} - \frac{2}{B_0^2} \sum_\sigma T_{0\sigma} n_{0\sigma} \Delta \f$
+         *gyroKernel; ///< gyro-averaging kernel including FFT normalization and Nyquist screening
+   
+  nct::allocate ArrayTables, ///< Array allocator for field solver terms
+                ArrayKernel; ///< Array allocator for gyroKernel
+
+  double tablesLy; ///< Ly used for current tables (changed by e.g. ScanLinearModes)
+
+  /**
+  *   @brief calculates the pre-calculated terms for the field solver and
+  *          gyro-averaging
+  *
+  **/
+  void calculateTables(double k2G0[NzLD][Nky][FFTSolver::X_NkxL], double Ap  [NzLD][Nky][FFTSolver::X_NkxL],
+                       double qnBD[NzLD][Nky][FFTSolver::X_NkxL], double TnBBD[NzLD][Nky][FFTSolver::X_NkxL],
+                       double kernel[Nq][NsLD][NmLD][NzLD][Nky][FFTSolver::X_NkxL]);
+
+  /**
+  *   @brief re-calculates the tables in case Ly changed
+  *
+  *   @note needs to be called by all threads
+  *
+  **/
+  void updateTables();
+
   /**
   *
   *   @brief Solved the field equations
@@ -297,6 +337,30 @@ class FieldsFFT : public Fields {
                       CComplex kXIn [Nq][NzLD][Nky][FFTSolver::X_NkxL],
                 const int m, const int s, bool stack=false);  
 
+  /**
+  *   @brief performs the gyro-averaging for all species and magnetic moments
+  *
+  *   The fields are transformed only once to Fourier space, where the 
+  *   averaging kernels (see gyroFull, gyroFirst) for all \f$ (\mu, \sigma) \f$ are 
+  *   applied. Finally, the whole stack is transformed back in a single (batched) 
+  *   transform.
+  *
+  **/
+  void gyroAverageFields(const CComplex Field0[Nq][NzLD][Nky][NxLD],
+                               CComplex Field [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]);
+  
+  /**
+  *   @brief performs the gyro-averaging of the velocity moments
+  *
+  *   For each magnetic moment, the 8 moments of all species are transformed
+  *   together to Fourier space, where the averaging kernel is applied and 
+  *   the sum over \f$ \mu \f$ is taken. The sum is transformed back in a single 
+  *   (batched) transform.
+  *
+  **/
+  void gyroAverageMoments(CComplex In [NmLD][8][NsLD][NzLD][Nky][NxLD],
+                          CComplex Out          [8][NsLD][NzLD][Nky][NxLD]);
+
   /**
   *   @brief performs the double gyro-averaging over Maxwellian in Fourier space
   * 
@@ -328,6 +392,15 @@ class FieldsFFT : public Fields {
   **/ 
   void getFieldEnergy(double& phiEnergy, double& ApEnergy, double& BpEnergy);
   
+  /**
+  *    @brief re-calculates pre-calculated terms 
+  *
+  *    Needs to be called if geometry or species parameters are changed.
+  *    Changes in Ly are detected automatically.
+  *
+  **/ 
+  void resetTables();
+  
 protected:
 
   /**
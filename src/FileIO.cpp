@@ -13,6 +13,7 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 #include <stddef.h>
 
 #include "FileIO.h"
@@ -29,7 +30,35 @@ FileIO::FileIO(Parallel *_parallel, Setup *setup)  :  parallel(_parallel)
   bool allowOverwrite  = setup->get("DataOutput.Overwrite", 0) || (setup->flags & Setup::GKC_OVERWRITE);
   
   dataFileFlushTiming  = Timing(setup->get("DataOutput.Flush.Step", -1), setup->get("DataOutput.Flush.Time", 100.)); 
-  resumeFile           = inputFileName != "";
+  resumeFile           = (inputFileName != "") || (setup->get("DataOutput.RawSnapshot.Input", "") != "");
+
+  // asynchronous output requires thread-safe MPI (for MPI-IO) 
+  asyncOutput          = setup->get("DataOutput.Async", 0);
+  asyncBuffer          = size_t(setup->get("DataOutput.AsyncBuffer", 1024)) << 20;
+
+  if(asyncOutput && (parallel->numProcesses > 1) && !parallel->threadMultiple) {
+    parallel->print("FileIO : MPI_THREAD_MULTIPLE not supported, using synchronous output");
+    asyncOutput = false;
+  }
+
+  scheduler            = new Scheduler(setup, parallel);
+
+  // records of tables (e.g. scalar values) are written in batches
+  TableAttr::bufferRows() = std::max(1, setup->get("DataOutput.Table.BufferRows", 64));
+
+  // compression of large datasets (phase space, fields, moments, visualization)
+  FileAttr::compression().level     = setup->get("DataOutput.Compression.Level"    , 0 );
+  FileAttr::compression().tolerance = setup->get("DataOutput.Compression.Tolerance", 0.);
+  
+  check(QuantizeFilter::registerFilter(), DMESG("H5Zregister"));
+
+#if defined(GKC_PARALLEL_MPI) && !H5_VERSION_GE(1,10,2)
+  // parallel HDF-5 supports writing filtered datasets only since version 1.10.2
+  if((parallel->numProcesses > 1) && (FileAttr::compression().level > 0 || FileAttr::compression().tolerance > 0.)) {
+    parallel->print("FileIO : compression requires parallel HDF-5 >= 1.10.2, writing uncompressed");
+    FileAttr::compression() = { 0, 0. };
+  }
+#endif
   
 #pragma warning (disable : 1875) // ignore warnings about non-POD types
   { // Create compound data types 
@@ -47,6 +76,16 @@ FileIO::FileIO(Parallel *_parallel, Setup *setup)  :  parallel(_parallel)
     complex_tid = H5Tcreate(H5T_COMPOUND, sizeof (ComplexSplit_t));
     H5Tinsert(complex_tid, "r", HOFFSET(ComplexSplit_t, r), H5T_NATIVE_DOUBLE);
     H5Tinsert(complex_tid, "i", HOFFSET(ComplexSplit_t, i), H5T_NATIVE_DOUBLE);
+
+    // phase-space function may be stored in single precision (see PComplex),
+    // HDF-5 converts between both types when reading e.g. a double precision restart file
+#ifdef GKC_PHASE_SINGLE
+    phase_tid = H5Tcreate(H5T_COMPOUND, sizeof (PComplex));
+    H5Tinsert(phase_tid, "r", 0            , H5T_NATIVE_FLOAT);
+    H5Tinsert(phase_tid, "i", sizeof(float), H5T_NATIVE_FLOAT);
+#else
+    phase_tid = H5Tcopy(complex_tid);
+#endif
     
     vector3D_tid = H5Tcreate(H5T_COMPOUND, sizeof (Vector3D));
     H5Tinsert(vector3D_tid, "x", HOFFSET(Vector3D, x), H5T_NATIVE_DOUBLE);
@@ -71,11 +110,18 @@ FileIO::FileIO(Parallel *_parallel, Setup *setup)  :  parallel(_parallel)
 
 FileIO::~FileIO()  
 {
+  // write buffered table records and finish queued writes
+  TableAttr::flushAll();
+  AsyncIO::stop();
+
+  delete scheduler;
+
   check(H5LTset_attribute_string(file, ".", "StopTime", System::getTimeString().c_str()), DMESG("HDF-5 Error"));
   // Free all HDF5 resources
 
   // close some extra stuff
   check( H5Tclose(complex_tid), DMESG("HDF-5 Error"));
+  check( H5Tclose(phase_tid  ), DMESG("HDF-5 Error"));
   check( H5Tclose(timing_tid ), DMESG("HDF-5 Error"));
   check( H5Tclose(species_tid), DMESG("HDF-5 Error"));
   check( H5Tclose(str_tid    ), DMESG("HDF-5 Error"));
@@ -84,30 +130,77 @@ FileIO::~FileIO()
   check( H5Fclose(file)    , DMESG("HDF-5 Error : Unable to close file ..."));
 }
 
-void FileIO::create(Setup *setup, bool allowOverwrite) 
+hid_t FileIO::getFileAccess(Setup *setup) 
 {
   hid_t file_apl = H5Pcreate(H5P_FILE_ACCESS);
 
 #ifdef GKC_PARALLEL_MPI
     MPI_Info file_info;
     check(MPI_Info_create(&file_info), DMESG("HDF-5 Error"));
-    // Note that using MPI_Info_set we can optimize HDF-5 MPI/IO writes
+
+    // MPI-IO hints for collective buffering and (Lustre) striping, ignored if zero
+    auto setHint = [&](std::string key, std::string hint) {
+      const int value = setup->get("DataOutput.MPIIO." + key, 0);
+      if(value > 0) check(MPI_Info_set(file_info, (char *) hint.c_str(), (char *) Setup::num2str(value).c_str()), DMESG("MPI_Info_set"));
+    };
+
+    setHint("StripeCount" , "striping_factor");
+    setHint("StripeSize"  , "striping_unit"  );
+    setHint("CBNodes"     , "cb_nodes"       );
+    setHint("CBBufferSize", "cb_buffer_size" );
+    
+    check(MPI_Info_set(file_info, (char *) "romio_cb_write", (char *) "enable"), DMESG("MPI_Info_set"));
 
     check( H5Pset_fapl_mpio(file_apl, parallel->Comm[DIR_ALL], file_info), DMESG("HDF-5 Error"));
 
-    // shouldn't be freed before H5Pclose(file_apl) ?
+    // H5Pset_fapl_mpio duplicates the info object
     MPI_Info_free(&file_info);
+
+    // align datasets (chunks) larger than 64 kB to stripe size, thus each process writes to
+    // separate stripes. Aggregate metadata into blocks of same size.
+    const hsize_t alignment = setup->get("DataOutput.Alignment", setup->get("DataOutput.MPIIO.StripeSize", 0));
+
+    if(alignment > 0) {
+      check( H5Pset_alignment     (file_apl, 65536, alignment), DMESG("HDF-5 Error"));
+      check( H5Pset_meta_block_size(file_apl, alignment)      , DMESG("HDF-5 Error"));
+    }
+
+#if H5_VERSION_GE(1,10,0)
+    // metadata is read by one process and broadcast, and written collectively from the metadata cache
+    // (requires that all metadata operations are called by all processes, thus only if requested)
+    if(setup->get("DataOutput.MPIIO.CollectiveMetadata", 0)) {
+      check( H5Pset_all_coll_metadata_ops(file_apl, true), DMESG("HDF-5 Error"));
+      check( H5Pset_coll_metadata_write  (file_apl, true), DMESG("HDF-5 Error"));
+    }
+#endif
+
 #endif
   
   // Close file even if some objects are still open (should generate warning)
   H5Pset_fclose_degree(file_apl, H5F_CLOSE_STRONG);
- 
-  // Create new output file
-  file = check(H5Fcreate(outputFileName.c_str(), (allowOverwrite ? H5F_ACC_TRUNC : H5F_ACC_EXCL),
-          H5P_DEFAULT, file_apl ), DMESG("HDF-5 Error : File already exists ? use -f to overwrite..."));
+
+  return file_apl;
+}
+
+hid_t FileIO::openFile(Setup *setup, std::string name, bool create, bool allowOverwrite)
+{
+  hid_t file_apl = getFileAccess(setup);
+
+  hid_t file_id = create ? H5Fcreate(name.c_str(), (allowOverwrite ? H5F_ACC_TRUNC : H5F_ACC_EXCL), H5P_DEFAULT, file_apl)
+                         : H5Fopen  (name.c_str(), H5F_ACC_RDWR, file_apl);
+
+  check(file_id, DMESG("HDF-5 Error : Cannot open " + name + (create ? " (file already exists ? use -f to overwrite...)" : "")));
      
   check( H5Pclose(file_apl), DMESG("HDF-5 Error"));
 
+  return file_id;
+}
+
+void FileIO::create(Setup *setup, bool allowOverwrite) 
+{
+  // Create new output file
+  file = openFile(setup, outputFileName, true, allowOverwrite);
+
   //////////////////////////////////////////////////////////////// Info Group ////////////////////////////////////////////////////////
    
   hid_t infoGroup = newGroup("/Info");
@@ -168,14 +261,24 @@ hid_t FileIO::newGroup(std::string name, hid_t parentNode)
 // to prevent corruption of HDF-5 file (requires regular calls to this->flush() ] 
 void FileIO::flush(Timing timing, double dt, bool force_flush)
 {
-  if(timing.check(dataFileFlushTiming, dt) || force_flush) H5Fflush(file, H5F_SCOPE_GLOBAL);
+  if(timing.check(dataFileFlushTiming, dt) || force_flush) {
+
+    // write buffered table records, queued after pending writes if output is asynchronous
+    TableAttr::flushAll();
+    AsyncIO::submit([=] { H5Fflush(file, H5F_SCOPE_GLOBAL); });
+  }
 }
 
 void FileIO::printOn(std::ostream &output) const 
 {
   output << "            -------------------------------------------------------------------" << std::endl
          << "Data       |  Input : " << (inputFileName == "" ? "---None---" : inputFileName)  << std::endl 
-         << "           | Output : " <<  outputFileName  << " Resume : " << (resumeFile ? "yes" : "no") << std::endl;
+         << "           | Output : " <<  outputFileName  << " Resume : " << (resumeFile ? "yes" : "no") 
+         << " Output : " << (asyncOutput ? "asynchronous (" + Setup::num2str(asyncBuffer >> 20) + " MB)" : "synchronous") << std::endl
+         << "           | Compression : " << (FileAttr::compression().level > 0 ? "deflate " + Setup::num2str(FileAttr::compression().level) : "off") 
+         << (FileAttr::compression().tolerance > 0. ? ", quantised (ε = " + Setup::num2str(FileAttr::compression().tolerance) + ")" : "") 
+         << " Table buffer : " << TableAttr::bufferRows() << " records" << std::endl
+         << *scheduler;
 }
 
 FileAttr* FileIO::newTiming(hid_t group, hsize_t offset, bool write)
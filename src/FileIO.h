@@ -22,6 +22,7 @@
 
 #include "SHDF5/FileAttr.h"
 #include "SHDF5/TableAttr.h"
+#include "Analysis/Scheduler.h"
 
 
 /**
@@ -44,6 +45,12 @@ class FileIO : public IfaceGKC
               info;              ///< additional information to append to the file
   
   void create(Setup *setup, bool allowOverwrite);
+
+  /**
+  *   @brief returns file access property list (MPI-IO driver and hints)
+  *
+  **/
+  hid_t getFileAccess(Setup *setup);
   
  public:
   
@@ -52,6 +59,22 @@ class FileIO : public IfaceGKC
   *
   *   Accepts following Setup parameters
   *
+  *     DataOutput.Async       : write output on background thread during time stepping (default 0)
+  *     DataOutput.AsyncBuffer : maximum size of queued output snapshots in MB (default 1024)
+  *
+  *     DataOutput.Compression.Level     : deflate level 1-9 (default 0, no compression)
+  *     DataOutput.Compression.Tolerance : absolute error bound of lossy quantisation 
+  *                                        (default 0, lossless with shuffle)
+  *
+  *   and for MPI-IO (collective writes), where zero uses the MPI-IO default
+  *
+  *     DataOutput.MPIIO.StripeCount  : number of file system stripes (striping_factor)
+  *     DataOutput.MPIIO.StripeSize   : stripe size in bytes (striping_unit)
+  *     DataOutput.MPIIO.CBNodes      : number of collective buffering aggregators (cb_nodes)
+  *     DataOutput.MPIIO.CBBufferSize : collective buffer size in bytes (cb_buffer_size)
+  *     DataOutput.Alignment          : alignment of datasets in bytes (default StripeSize)
+  *     DataOutput.MPIIO.CollectiveMetadata : collective metadata operations (HDF-5 >= 1.10, default 0),
+  *                                           requires that all metadata operations are called by all processes
   *
   **/
   FileIO(Parallel *parallel, Setup *setup);
@@ -72,6 +95,7 @@ class FileIO : public IfaceGKC
   void flush(Timing timing, double dt, bool force_flush=false);
    
   hid_t   complex_tid, ///< Complex Data type
+            phase_tid, ///< Complex Data type of phase-space function (PComplex)
            timing_tid, ///< Type id for Timing 
           species_tid, ///< species HDF-5 type id (where is it used ?)
         specfield_tid, ///< [ Species, 3 ] type for heat/particle flux
@@ -84,6 +108,25 @@ class FileIO : public IfaceGKC
 
   bool resumeFile; ///< true if simulation resumed from input file 
 
+  bool   asyncOutput; ///< true if output is written by I/O thread during time stepping (see AsyncIO)
+  size_t asyncBuffer; ///< maximum size of queued output snapshots (in bytes)
+
+  Scheduler *scheduler; ///< central scheduler of diagnostics output (see Scheduler)
+
+  /**
+  *   @brief Creates or opens (read/write) an additional HDF-5 file
+  *
+  *   Uses same file access properties as the main output file.
+  *
+  *   @param name           file name
+  *   @param create         if true create new file, otherwise open existing file
+  *   @param allowOverwrite truncate file if it already exists
+  *
+  *   @return file id (to be closed by caller)
+  *
+  **/
+  hid_t openFile(Setup *setup, std::string name, bool create, bool allowOverwrite=true);
+
   /**
   *   @brief Created and returns a new group
   *
@@ -64,6 +64,9 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   parallel->print("Initializing GKC++\n");
 
   fileIO    = new FileIO(parallel, setup);
+  
+  // set owner of following allocations for the memory registry
+  nct::allocate::setOwner("Grid");
   grid      = new Grid(setup, parallel, fileIO);
 
   // ugly here, however in parallel constructor fileIO is not defined yet
@@ -72,6 +75,7 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   bench      = new Benchmark(setup, parallel, fileIO); 
   bench_pmpi = new Benchmark_PMPI(setup, parallel, fileIO); 
 
+  nct::allocate::setOwner("Geometry");
   if     (geometry_Type == "SA"   ) geometry  = new GeometrySA(setup, grid, fileIO);
   else if(geometry_Type == "2D"   ) geometry  = new Geometry2D(setup, grid, fileIO);
   else if(geometry_Type == "Slab" ) geometry  = new GeometrySlab(setup, grid, fileIO);
@@ -81,6 +85,7 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   plasma    = new Plasma(setup, fileIO, geometry);
 
   // Load fft-solver 
+  nct::allocate::setOwner("FFTSolver");
   if(fft_solver_name == "") check(-1, DMESG("No FFT Solver Name given"));
 #ifdef FFTW3
   else if(fft_solver_name == "fftw3") fftsolver = new FFTSolver_fftw3(setup, parallel, geometry);
@@ -88,6 +93,7 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   else check(-1, DMESG("No such FFTSolver name"));
  
   // Load field solver
+  nct::allocate::setOwner("Fields");
   if     (psolver_type == "DFT"    ) fields   = new FieldsFFT(setup, grid, parallel, fileIO, geometry, fftsolver);
 #ifdef GKC_HYPRE
   else if(psolver_type == "Hypre"  ) fields   = new FieldsHypre(setup, grid, parallel, fileIO,geometry, fftsolver);
@@ -96,12 +102,17 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   else    check(-1, DMESG("No such Fields Solver"));
   
   // Load Collisonal Operator
+  nct::allocate::setOwner("Collisions");
   if     (collision_type == "None"      ) collisions = new Collisions                (grid, parallel, setup, fileIO, geometry); 
   else if(collision_type == "LB"        ) collisions = new Collisions_LenardBernstein(grid, parallel, setup, fileIO, geometry); 
   else if(collision_type == "PitchAngle") collisions = new Collisions_PitchAngle     (grid, parallel, setup, fileIO, geometry); 
   else    check(-1, DMESG("No such Collisions Solver"));
+
+  // velocity moments for collisions are calculated together with the field sources
+  if(collisions->requiresMoments()) fields->requestMoments();
     
   // Load Vlasov Solver
+  nct::allocate::setOwner("Vlasov");
   if(vlasov_type == "None" ) check(-1, DMESG("No Vlasov Solver Selected"));
   else if(vlasov_type == "Cilk"   ) vlasov  = new VlasovCilk  (grid, parallel, setup, fileIO, geometry, fftsolver, bench, collisions);
   else if(vlasov_type == "Aux"    ) vlasov  = new VlasovAux   (grid, parallel, setup, fileIO, geometry, fftsolver, bench, collisions);
@@ -110,6 +121,7 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   else   check(-1, DMESG("No such Fields Solver"));
   
   // Load some other general modules
+  nct::allocate::setOwner("Diagnostics");
   diagnostics     = new Diagnostics(parallel, vlasov, fields, grid, setup, fftsolver, fileIO, geometry); 
   visual          = new Visualization_Data(grid, parallel, setup, fileIO, vlasov, fields);
   event           = new Event(setup, grid, parallel, fileIO, geometry);
@@ -118,6 +130,7 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   control         = new Control(setup, parallel, diagnostics);
   particles       = new TestParticles(fileIO, setup, parallel);
  
+  nct::allocate::setOwner("TimeIntegration");
   if     (timeInt_type == "Explicit") timeIntegration = new TimeIntegration      (setup, grid, parallel, vlasov, fields, particles, eigenvalue, bench);
   else if(timeInt_type == "Implicit") timeIntegration = new TimeIntegration_PETSc(setup, grid, parallel, vlasov, fields, particles, eigenvalue, bench);
   else   check(-1, DMESG("No such TimeIntegratioScheme in GKC.TimeIntegration"));
@@ -127,7 +140,10 @@ GKC::GKC(Setup *_setup) : setup(_setup)
   // Optimize values to speed up computation
   bench->bench(vlasov, fields);
   
+  nct::allocate::setOwner("Unknown");
+  
   printSettings();   
+  writeMemory();
   setup->check_config();
 }
 
@@ -147,6 +163,9 @@ int GKC::mainLoop()
     timeIntegration->setMaxLinearTimeStep(eigenvalue, vlasov, fields);
 
     bool isOK = true; 
+
+    // output is written by background thread while time stepping continues
+    if(fileIO->asyncOutput) AsyncIO::start(fileIO->asyncBuffer);
          
     ////////////////////////  Starting OpenMP global threads   /////////////////////////
     //
@@ -172,15 +191,23 @@ int GKC::mainLoop()
         // integrate for one time-step, give current dt as output
         const double dt = timeIntegration->solveTimeStep(vlasov, fields, particles, timing);     
         bench->stop("A", 1);
-        // Analysis results and output data (currently singlethreaded)
+        // Output data (singlethreaded, writes are only queued if output is asynchronous)
         #pragma omp master
         {
-          
+          // decide which diagnostics are written in this time step
+          fileIO->scheduler->plan(timing, dt);
+
           vlasov->writeData(timing, dt);
           fields->writeData(timing, dt);
           visual->writeData(timing, dt);
+        }
+        #pragma omp barrier
+
+        // Analysis results are calculated by all threads (output is serialized internally)
+        diagnostics->writeData(timing, dt);
 
-          diagnostics->writeData(timing, dt);
+        #pragma omp master
+        {
           event->checkEvent(timing, vlasov, fields);
 
           // flush in regular intervals in order to minimize HDF-5 file 
@@ -195,8 +222,13 @@ int GKC::mainLoop()
       } while(isOK);
 
     } // parallel section
+
+    // write buffered table records and finish queued output (subsequent HDF-5 calls are synchronous)
+    fileIO->flush(timing, 0., true);
+    AsyncIO::stop();
    
     control->printLoopStopReason();
+    fileIO->scheduler->printStatistics();
 
   }  
   else if(gkc_SolType == "Eigenvalue") {
@@ -262,10 +294,118 @@ void GKC::printSettings()
     << "-------------------------------------------------------------------------------" << std::endl
     << *grid << *plasma << *fileIO << *setup << *vlasov  << *fields << *geometry << *init << *parallel << *fftsolver << *timeIntegration << *collisions;
     
-  infoStream << *control << *bench << std::endl;
+  infoStream << *control << *bench;
+  
+  printMemory(infoStream);
+  infoStream << std::endl;
   infoStream << "-------------------------------------------------------------------------------" << std::endl << std::endl << std::flush;
 
   parallel->print(infoStream.str());
 
 }
+
+void GKC::printMemory(std::ostream &output)
+{
+  const nct::alloc_registry &reg = nct::allocate::registry();
+  
+  auto toMB = [](size_t bytes) -> double { return bytes / double(1 << 20); };
+
+  output << std::fixed << std::setprecision(1);
+  output << "Memory     | Peak : " << toMB(reg.bytesPeak) << " MB  (per process)" << std::endl;
+  
+  for(auto &mod : reg.bytesOwner) {
+    
+    if(mod.second == 0) continue;
     
+    output << "Memory     |   " << std::setw(16) << std::left << mod.first << " : " 
+           << std::setw(10) << std::right << toMB(mod.second) << " MB" << std::endl;
+  }
+  output << std::defaultfloat;
+}
+
+void GKC::writeMemory()
+{
+  const nct::alloc_registry &reg = nct::allocate::registry();
+  
+  // attributes have to be equal on all processes, thus we store the maximum 
+  hid_t infoGroup = check(H5Gopen(fileIO->getFileID(), "/Info", H5P_DEFAULT), DMESG("H5Gopen"));
+  
+  double peak = parallel->reduce(reg.bytesPeak / double(1 << 20), Op::max);
+  check(H5LTset_attribute_double(infoGroup, ".", "MemoryPeak", &peak, 1), DMESG("H5LTset_attribute"));
+
+  for(auto &mod : reg.bytesOwner) {
+    
+    double mem = parallel->reduce(mod.second / double(1 << 20), Op::max);
+    check(H5LTset_attribute_double(infoGroup, ".", ("Memory" + mod.first).c_str(), &mem, 1), DMESG("H5LTset_attribute"));
+  }
+
+  H5Gclose(infoGroup);
+}
+
+void GKC::estimateMemory(Setup *setup)
+{
+  // no MPI initialization for a dry-run, thus the decomposition has to be given explicitly
+  int decomp[6] = { 1, 1, 1, 1, 1, 1 };
+  
+  if(!Parallel::readDecomposition(setup, decomp)) check(-1, DMESG("Dry-run requires Parallel.Decomposition (Auto is not supported)"));
+  
+  const int numThreads = decomp[DIR_Y];
+  decomp[DIR_Y] = 1; // Y is decomposed over OpenMP threads only (see Parallel)
+
+  // local domain sizes and ranges as used by the allocations (same size on all processes)
+  Grid *grid = new Grid(setup, decomp);
+
+  Nq = (setup->get("Plasma.Beta", 0.) > 0.) ? 2 : 1;
+  Nq = (setup->get("Plasma.Bp"  , 0 ) == 1) ? 3 : Nq;
+
+  const size_t c16     = sizeof(CComplex), 
+               p16     = sizeof(PComplex);
+
+  // phase space (see Vlasov.cpp)
+  const size_t numPhase = nct::allocate(grid->RsLD, grid->RmLB, grid->RzLB, grid->RkyLD, grid->RxLB, grid->RvLB).getNum();
+  
+  nct::allocate::setOwner("Vlasov");
+  nct::allocate::record("Phase space"         , 4 * numPhase * p16);
+  nct::allocate::record("Maxwellian"          , nct::allocate(grid->RsLD, grid->RmLB, grid->RzLB, grid->RxLB, grid->RvLB).getNum() * sizeof(double));
+  nct::allocate::record("Gyro-averaged fields", (nct::allocate(grid->RzLB, grid->RkyLD, grid->RxLB4, grid->RvLB).getNum() 
+                                               + nct::allocate(grid->RzLB, grid->RkyLD, grid->RxLB , grid->RvLB).getNum()) * c16);
+  nct::allocate::record("Non-linear term"     , nct::allocate(grid->RkyLD, grid->RxLD, grid->RvLD).getNum() * c16);
+  nct::allocate::record("Boundary buffers"    , 4 * (    2 * Nky * NzLD * NvLD * NmLD * NsLD + NxLD * Nky *    2 * NvLD * NmLD * NsLD 
+                                               + NxLD * Nky * NzLD *    2 * NmLD * NsLD 
+                                               + ((NmLlD == NmLlB) ? 0 : NxLD * Nky * NzLD * NvLD * 2 * NsLD)) * p16);
+
+  // fields, sources and field solver tables (see Fields.cpp, FieldsFFT.cpp), for the kernel 
+  // we assume an equal partition of k_x
+  nct::allocate::setOwner("Fields");
+  nct::allocate::record("Fields"              , nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD, grid->RzLB, grid->RkyLD, nct::Range(NxLlD-4, NxLD+8)).getNum() * c16);
+  nct::allocate::record("Field stack"         , nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD, grid->RzLD, grid->RkyLD, grid->RxLD).getNum() * c16);
+  nct::allocate::record("Gyro-average kernel" , nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RmLD, grid->RzLD, grid->RkyLD, grid->RxLD).getNum() * sizeof(double));
+
+#ifdef FFTW3
+  // for an equal partition, the local size of fftw-mpi is NxLD * howmany
+  nct::allocate::setOwner("FFTSolver");
+  nct::allocate::record("FFTW buffers"        , FFTSolver_fftw3::getBufferBytes(decomp[DIR_X] == 1, FFTSolver_fftw3::getNumAlloc(NxLD, Nq), 
+                                                                                NxLD * Nky * NzLD * Nq * NsLD * NmLD, NxLD * Nky * NzLD * 8 * NsLD));
+#endif
+
+  // moments (of each \mu) and fluxes, shared by threads during output (see Moments.cpp, Diagnostics.cpp)
+  nct::allocate::setOwner("Diagnostics");
+  nct::allocate::record("Moments"             , (nct::allocate(grid->RmLD, nct::Range(0,8), grid->RsLD, grid->RzLD, grid->RkyLD, grid->RxLD).getNum() 
+                                               + nct::allocate(nct::Range(0,8), grid->RsLD, grid->RzLD, grid->RkyLD, grid->RxLD).getNum()) * c16);
+  nct::allocate::record("Fluxes"              , (2 * nct::allocate(nct::Range(0,Nq), grid->RsLD, grid->RkyLD, grid->RxLD).getNum() 
+                                               +     nct::allocate(nct::Range(0,Nq), nct::Range(0,3), grid->RsLD, grid->RkyLD, grid->RxLD).getNum()) * sizeof(double));
+
+  // snapshots of queued output (at least one phase-space snapshot, see AsyncIO)
+  if(setup->get("DataOutput.Async", 0)) {
+    nct::allocate::setOwner("FileIO");
+    nct::allocate::record("Output staging"    , std::max<size_t>(numPhase * p16, size_t(setup->get("DataOutput.AsyncBuffer", 1024)) << 20));
+  }
+  
+  std::cout << "Memory estimate for decomposition " 
+            << decomp[DIR_X] << ":" << numThreads << ":" << decomp[DIR_Z] << ":" 
+            << decomp[DIR_V] << ":" << decomp[DIR_M] << ":" << decomp[DIR_S] << std::endl
+            << "-------------------------------------------------------------------------------" << std::endl;
+  printMemory(std::cout);
+  
+  delete grid;
+}
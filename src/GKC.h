@@ -85,6 +85,18 @@ class GKC
   
   void printSettings();
 
+  /**
+  *  @brief print peak and per-module memory usage
+  *
+  **/
+  static void printMemory(std::ostream &output);
+
+  /**
+  *  @brief write peak and per-module memory usage to /Info
+  *
+  **/
+  void writeMemory();
+
  public:
    
   /**
@@ -93,6 +105,17 @@ class GKC
   **/
   GKC(Setup *setup);
  ~GKC();  
+
+  /**
+  *  @brief estimate memory footprint without allocating (dry-run)
+  *
+  *  Only the dominant arrays of the phase space, fields and the
+  *  FFT solver are included, sizes are per process. MPI is not
+  *  initialized, thus Parallel.Decomposition has to be set and the
+  *  local ranges are taken from Grid (see Grid::setDomain).
+  *
+  **/
+  static void estimateMemory(Setup *setup);
    
   int mainLoop();
 };
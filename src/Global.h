@@ -33,6 +33,15 @@ typedef _Complex double CComplex;
 typedef double               Real   ;
 #define _imag ((CComplex) (0.+1.j)) 
 
+// Storage type of the phase space function (f, fs, fss, ft). If configured with 
+// GKC_PHASE_SINGLE it is stored in single precision, while all arithmetic is 
+// performed in double precision (values are promoted when loaded).
+#ifdef GKC_PHASE_SINGLE
+typedef _Complex float  PComplex;
+#else
+typedef _Complex double PComplex;
+#endif
+
 // align to cache-lines (use attributes with c++-11 ?!)
 typedef __declspec(align(64)) double     doubleAA;
 typedef __declspec(align(64)) CComplex CComplexAA;
@@ -161,7 +170,12 @@ typedef __declspec(align(64)) CComplex(*A4zz)[0][0][0];
 typedef __declspec(align(64)) CComplex(*A3zz)[0][0];
 typedef __declspec(align(64)) CComplex(*A2zz)[0];
 
+typedef __declspec(align(64)) PComplex(*A6pp)[0][0][0][0][0];
+
 typedef __declspec(align(64)) double(*A2rr)[0];
 typedef __declspec(align(64)) double(*A3rr)[0][0];
+typedef __declspec(align(64)) double(*A4rr)[0][0][0];
+typedef __declspec(align(64)) double(*A5rr)[0][0][0][0];
+typedef __declspec(align(64)) double(*A6rr)[0][0][0][0][0];
 
 #endif // __GLOBAL_H
@@ -50,7 +50,51 @@ Grid:: Grid (Setup *setup, Parallel *parallel, FileIO *fileIO)
 {
   
   muIntegrationType = setup->get("Grid.MuIntegrationType", "Gauss-Legendre");
+
+  setDomain(setup, parallel->decomposition, parallel->Coord);
+ 
+  ///////////////  Set Grid  Domain ////////////
+
+  // X (Note : For gyro-averaged fields we have extended boundaries
+  ArrayX = nct::allocate(nct::Range(NxGlB-2, NxGB+4))(&X);
+  ArrayZ = nct::allocate(RzGB)(&Z);
+  ArrayV = nct::allocate(RvGB)(&V);
+  ArrayM = nct::allocate(RmGB)(&M, &dm);
+
+  // Use  equidistant grid for X, Z and V
+  bool includeX0Point = setup->get("Grid.IncludeX0Point", 0);
+  for(int x = NxGlB-2; x <= NxGuB+2; x++) X[x] = -Lx/2. + dx * (x - NxGC - 1) + ((includeX0Point) ? dx/2. : 0.);
+  //for(int z = NzGlB; z <= NzGuB; z++) Z[z] = -Lz/2. + dz * (z - NzGC - 1) ;
+  for(int z = NzGlB; z <= NzGuB; z++) Z[z] =  dz * (z - NzGC - 1) ;
+  for(int v = NvGlB; v <= NvGuB; v++) V[v] = -Lv + dv * (v - NvGlD);
     
+  // M For mu we can choose between various integration type e.g. rectangle or Gaussian
+  // @todo use setup to define integration method
+  Integrate integrate(muIntegrationType, Nm, 0., Lm);
+
+  for(int m = NmGlD, n = 0; m <= NmGuD; m++, n++) {
+
+    M [m] = (Nm == 1) ? 0. : integrate.x(n) ; 
+    dm[m] = (Nm == 1) ? 1. : integrate.w(n); 
+  }
+
+  // Set local Jacobian (better use geometry module ?)
+  dXYZ  = dx * dy * dz;
+  dXYZV = dx * dy * dz * dv;
+
+  initData(fileIO);
+}
+
+Grid::Grid(Setup *setup, const int decomposition[6]) : dm(nullptr)
+{
+  // sizes are equal on all processes (equal partition), thus use first one 
+  const int Coord[6] = { 0, 0, 0, 0, 0, 0 };
+  
+  setDomain(setup, decomposition, Coord);
+}
+
+void Grid::setDomain(Setup *setup, const int decomposition[6], const int Coord[6])
+{
   // Set Initial conditions
  
   // Global Domain Grid Number
@@ -103,33 +147,33 @@ Grid:: Grid (Setup *setup, Parallel *parallel, FileIO *fileIO)
   // Currently we only have equal partition decomposition
 
   // Set local decomposition indices for X
-  NxLlD = (NxGuD - NxGlD + 1)/parallel->decomposition[DIR_X] * parallel->Coord[DIR_X] + NxGC + 1;
-  NxLuD = (NxGuD - NxGlD + 1)/parallel->decomposition[DIR_X] * (parallel->Coord[DIR_X]+1) + NxGC;
+  NxLlD = (NxGuD - NxGlD + 1)/decomposition[DIR_X] * Coord[DIR_X] + NxGC + 1;
+  NxLuD = (NxGuD - NxGlD + 1)/decomposition[DIR_X] * (Coord[DIR_X]+1) + NxGC;
   NxLlB = NxLlD - NxGC; NxLuB = NxLuD + NxGC;
 
   // Set local decomposition indices for Y (wtf?)
-  NyLlD = (NyGuD - NyGlD + 1)/parallel->decomposition[DIR_Y] *  parallel->Coord[DIR_Y] + NyGC + 1;
-  NyLuD = (NyGuD - NyGlD + 1)/parallel->decomposition[DIR_Y] * (parallel->Coord[DIR_Y]+ 1) + NyGC;
+  NyLlD = (NyGuD - NyGlD + 1)/decomposition[DIR_Y] *  Coord[DIR_Y] + NyGC + 1;
+  NyLuD = (NyGuD - NyGlD + 1)/decomposition[DIR_Y] * (Coord[DIR_Y]+ 1) + NyGC;
   NyLlB = NyLlD - NyGC; NyLuB = NyLuD + NyGC;
 
   // Set local decomposition indices for Z
-  NzLlD = (NzGuD - NzGlD + 1)/parallel->decomposition[DIR_Z] *  parallel->Coord[DIR_Z] + NzGC + 1;
-  NzLuD = (NzGuD - NzGlD + 1)/parallel->decomposition[DIR_Z] * (parallel->Coord[DIR_Z]+1) + NzGC;
+  NzLlD = (NzGuD - NzGlD + 1)/decomposition[DIR_Z] *  Coord[DIR_Z] + NzGC + 1;
+  NzLuD = (NzGuD - NzGlD + 1)/decomposition[DIR_Z] * (Coord[DIR_Z]+1) + NzGC;
   NzLlB =  NzLlD - NzGC; NzLuB = NzLuD + NzGC;
     
   // Set local decomposition indices for V
-  NvLlD = (NvGuD - NvGlD + 1)/parallel->decomposition[DIR_V] *  parallel->Coord[DIR_V] + NvGC + 1;
-  NvLuD = (NvGuD - NvGlD + 1)/parallel->decomposition[DIR_V] * (parallel->Coord[DIR_V] + 1) + NvGC;
+  NvLlD = (NvGuD - NvGlD + 1)/decomposition[DIR_V] *  Coord[DIR_V] + NvGC + 1;
+  NvLuD = (NvGuD - NvGlD + 1)/decomposition[DIR_V] * (Coord[DIR_V] + 1) + NvGC;
   NvLlB = NvLlD - NvGC; NvLuB = NvLuD + NvGC;
     
   // Set local decomposition indices for M (no boundary)
-  NmLlD = (NmGuD - NmGlD + 1)/parallel->decomposition[DIR_M] *  parallel->Coord[DIR_M] + 1;
-  NmLuD = (NmGuD - NmGlD + 1)/parallel->decomposition[DIR_M] * (parallel->Coord[DIR_M] + 1) ;
+  NmLlD = (NmGuD - NmGlD + 1)/decomposition[DIR_M] *  Coord[DIR_M] + 1;
+  NmLuD = (NmGuD - NmGlD + 1)/decomposition[DIR_M] * (Coord[DIR_M] + 1) ;
   NmLlB = NmLlD - NmGC; NmLuB = NmLuD + NmGC; 
 
   // Set local decomposition indices for S (no boundary)
-  NsLlD = (NsGuD - NsGlD + 1)/parallel->decomposition[DIR_S] *  parallel->Coord[DIR_S] + 1;
-  NsLuD = (NsGuD - NsGlD + 1)/parallel->decomposition[DIR_S] * (parallel->Coord[DIR_S] + 1) ;
+  NsLlD = (NsGuD - NsGlD + 1)/decomposition[DIR_S] *  Coord[DIR_S] + 1;
+  NsLuD = (NsGuD - NsGlD + 1)/decomposition[DIR_S] * (Coord[DIR_S] + 1) ;
   NsLlB = NsLlD; NsLuB = NsLuD; 
 
   // Set number of local domain points
@@ -177,37 +221,6 @@ Grid:: Grid (Setup *setup, Parallel *parallel, FileIO *fileIO)
   RvGD.setRange(NvGlD, Nv);
   RmGD.setRange(NmGlD, Nm);
   RsGD.setRange(NsGlD, Ns);
- 
-  ///////////////  Set Grid  Domain ////////////
-
-  // X (Note : For gyro-averaged fields we have extended boundaries
-  ArrayX = nct::allocate(nct::Range(NxGlB-2, NxGB+4))(&X);
-  ArrayZ = nct::allocate(RzGB)(&Z);
-  ArrayV = nct::allocate(RvGB)(&V);
-  ArrayM = nct::allocate(RmGB)(&M, &dm);
-
-  // Use  equidistant grid for X, Z and V
-  bool includeX0Point = setup->get("Grid.IncludeX0Point", 0);
-  for(int x = NxGlB-2; x <= NxGuB+2; x++) X[x] = -Lx/2. + dx * (x - NxGC - 1) + ((includeX0Point) ? dx/2. : 0.);
-  //for(int z = NzGlB; z <= NzGuB; z++) Z[z] = -Lz/2. + dz * (z - NzGC - 1) ;
-  for(int z = NzGlB; z <= NzGuB; z++) Z[z] =  dz * (z - NzGC - 1) ;
-  for(int v = NvGlB; v <= NvGuB; v++) V[v] = -Lv + dv * (v - NvGlD);
-    
-  // M For mu we can choose between various integration type e.g. rectangle or Gaussian
-  // @todo use setup to define integration method
-  Integrate integrate(muIntegrationType, Nm, 0., Lm);
-
-  for(int m = NmGlD, n = 0; m <= NmGuD; m++, n++) {
-
-    M [m] = (Nm == 1) ? 0. : integrate.x(n) ; 
-    dm[m] = (Nm == 1) ? 1. : integrate.w(n); 
-  }
-
-  // Set local Jacobian (better use geometry module ?)
-  dXYZ  = dx * dy * dz;
-  dXYZV = dx * dy * dz * dv;
-
-  initData(fileIO);
 }
 
 Grid::~Grid () 
@@ -228,10 +241,10 @@ void Grid::printOn(std::ostream &output) const
          << std::setw(4)          << (doGyro ? std::string( "  Nμ : ") + Setup::num2str(Nm) : "") << std::endl;
 }
     
-void Grid::initData(FileIO *fileIO) 
+void Grid::initData(FileIO *fileIO, hid_t file) 
 {
 
-  hid_t gridGroup = fileIO->newGroup("/Grid");
+  hid_t gridGroup = fileIO->newGroup("/Grid", file);
   
   // set lengths
   check(H5LTset_attribute_double(gridGroup, ".", "Lx", &Lx, 1), DMESG("HDF-5 Error"));
@@ -56,6 +56,16 @@ class Grid : public IfaceGKC {
 
   std::string  muIntegrationType; ///< Integration type in \f$\mu \f$ dimension
 
+  /**
+  *    @brief set global and local domain sizes and their ranges
+  *
+  *    @param setup         configuration parameters
+  *    @param decomposition number of processes in each direction
+  *    @param Coord         coordinate of process in each direction
+  *
+  **/
+  void setDomain(Setup *setup, const int decomposition[6], const int Coord[6]);
+
 
  public:
 
@@ -95,6 +105,15 @@ class Grid : public IfaceGKC {
   /// Constructor
   Grid(Setup *setup, Parallel *parallel, FileIO *fileIO);
 
+  /**
+  *    @brief sets only the domain (no grid values and output), e.g. for a dry-run
+  *
+  *    @param setup         configuration parameters
+  *    @param decomposition number of processes in each direction
+  *
+  **/
+  Grid(Setup *setup, const int decomposition[6]);
+
   /// Destructor
  ~Grid();
 
@@ -108,10 +127,13 @@ class Grid : public IfaceGKC {
   /**
   *    @brief saves grid information to output file
   *
+  *    Also written to restart files (see Vlasov), as required for
+  *    interpolation to a different resolution.
   *
   *    @param fileIO class
+  *    @param file   HDF-5 file (default : output file)
   **/
-  void initData(FileIO *fileIO);
+  void initData(FileIO *fileIO, hid_t file=-2);
    
   /// Class information
   virtual void writeData(const Timing &timing, const double dt) {};
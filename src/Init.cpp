@@ -29,18 +29,18 @@ Init::Init(Parallel *parallel, Grid *grid, Setup *setup, FileIO *fileIO, Vlasov
   // Only perturb if simulation is not resumed
   if(fileIO->resumeFile == false) {
 
-    initBackground(setup, grid, (A6zz) vlasov->f0, (A6zz) vlasov->f);
+    initBackground(setup, grid, (A5rr) vlasov->f0, (A6pp) vlasov->f);
     
     // Note : do not perturb m=0 modes as this perturbs directly energy and density of f1 
     //        also m=Nky-1 mode is not perturbed as it is not evolved (Nyquist)
     if     (PerturbationMethod == "NoPerturbation") ;
-    else if(PerturbationMethod == "EqualModePower")  PerturbationPSFMode ((A6zz) vlasov->f0, (A6zz) vlasov->f); 
-    else if(PerturbationMethod == "Noise"         )  PerturbationPSFNoise((A6zz) vlasov->f0, (A6zz) vlasov->f); 
-    else if(PerturbationMethod == "Exp"           )  PerturbationPSFExp  ((A6zz) vlasov->f0, (A6zz) vlasov->f); 
+    else if(PerturbationMethod == "EqualModePower")  PerturbationPSFMode ((A5rr) vlasov->f0, (A6pp) vlasov->f); 
+    else if(PerturbationMethod == "Noise"         )  PerturbationPSFNoise((A5rr) vlasov->f0, (A6pp) vlasov->f); 
+    else if(PerturbationMethod == "Exp"           )  PerturbationPSFExp  ((A5rr) vlasov->f0, (A6pp) vlasov->f); 
     else check(-1, DMESG("No such Perturbation Method"));  
    
    // Field is first index, is last index not better ? e.g. write as vector ?
-   [=] (CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvLB], CComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
+   [=] (double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB], PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
         CComplex Field0[Nq][NzLD][Nky][NxLD]          , CComplex Field[Nq][NsLD][NmLB][NzLB][Nky][NxLB+4],
         CComplex      Q[Nq][NzLD][Nky][NxLD])
    {
@@ -90,26 +90,25 @@ Init::Init(Parallel *parallel, Grid *grid, Setup *setup, FileIO *fileIO, Vlasov
    for(int z = NzLlD; z <= NzLuD; z++) { for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) {  for(int x = NxLlD; x <= NxLuD; x++) {
  
         f[s][m][z][y_k][x][v]  +=  ((Nq >= 2) ? species[s].sigma * species[s].alpha * V[v]*geo->eps_hat 
-                                                    * f0[s][m][z][y_k][x][v] * plasma->beta * Field[Field::Ap][s][m][z][y_k][x] : 0.);
+                                                    * f0[s][m][z][x][v] * plasma->beta * Field[Field::Ap][s][m][z][y_k][x] : 0.);
    }}} }}}
 
     
-   } ( (A6zz) vlasov->f0, (A6zz) vlasov->f, (A4zz) fields->Field0, (A6zz) fields->Field, (A4zz) fields->Q);
+   } ( (A5rr) vlasov->f0, (A6pp) vlasov->f, (A4zz) fields->Field0, (A6zz) fields->Field, (A4zz) fields->Q);
 
    ////////////////////////////////////////////////////////    Set Fixed Fields  phi, Ap, Bp //////////////////
 
    }
    
    //////////////////////////////////////// Done ///////////////
-   // Boundaries and Done   
-   vlasov->setBoundary( vlasov->f0   );
+   // Boundaries and Done (f0 is already set including boundaries)
    vlasov->setBoundary( vlasov->f    );
    fields->updateBoundary(); 
 }
 
 void Init::initBackground(Setup *setup, Grid *grid, 
-                          CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
-                          CComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
+                          double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                          PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
 {
   ////////////////////////////////////////////////////  Initial Condition Maxwellian f0 = (...) ///////////////
   
@@ -121,8 +120,9 @@ void Init::initBackground(Setup *setup, Grid *grid,
     FunctionParser f0_parser = setup->getFParser();
     check(((f0_parser.Parse(species[s].f0_str, "x,z,v,m,n,T") == -1) ? 1 : -1), DMESG("Parsing error of Initial condition n(x)"));
    
+    // f0 is independent of k_y, thus evaluated only once
     for(int m   = NmLlB ; m   <= NmLuB ;   m++) {  for(int z = NzLlB; z <= NzLuB; z++) { 
-    for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) {  for(int x = NxLlB; x <= NxLuB; x++) { 
+    for(int x = NxLlB; x <= NxLuB; x++) { 
       
       const double n = species[s].n[x];
       const double T = species[s].T[x];
@@ -135,21 +135,25 @@ void Init::initBackground(Setup *setup, Grid *grid,
         // although only F0(x,k_y=0,...) is not equal zero, we perturb all modes, as F0 in Fourier space "acts" like a nonlinearity,
         // which couples modes together
         //const double pos[6] = { X[x], Z[z], V[v], M[m], species[s].n[x], species[s].T[x] };
+        // M is only defined inside the global domain (ghost cells in mu are zero)
+        if((m < NmGlD) || (m > NmGuD)) { f0[s][m][z][x][v] = 0.; continue; }
+
         const double pos[6] = { X[x], Z[z], V[v], M[m], 1., 1. };
 
-        f0[s][m][z][y_k][x][v]  =  f0_parser.Eval(pos); 
+        f0[s][m][z][x][v]  =  f0_parser.Eval(pos); 
 
-      } } } } }
+      } } } }
 
    if(plasma->global == false)  f [NsLlD:NsLD][NmLlB:NmLB][NzLlB:NzLB][:][NxLlB:NxLB][NvLlB:NvLB] = ((CComplex) 0.e0);
-   else                         f [NsLlD:NsLD][NmLlB:NmLB][NzLlB:NzLB][:][NxLlB:NxLB][NvLlB:NvLB] =
-                                f0[NsLlD:NsLD][NmLlB:NmLB][NzLlB:NzLB][:][NxLlB:NxLB][NvLlB:NvLB];
+   else for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) 
+                                f [NsLlD:NsLD][NmLlB:NmLB][NzLlB:NzLB][y_k][NxLlB:NxLB][NvLlB:NvLB] =
+                                f0[NsLlD:NsLD][NmLlB:NmLB][NzLlB:NzLB]     [NxLlB:NxLB][NvLlB:NvLB];
   }
 }
 
 ///////////////////// functions for initial perturbation //////////////////////
-void Init::PerturbationPSFNoise(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
-                                      CComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
+void Init::PerturbationPSFNoise(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                      PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
 { 
   // add s to initialization of RNG due to fast iteration over s (which time is not resolved)
   for(int s = NsLlD; s <= NsLuD; s++) { 
@@ -161,14 +165,14 @@ void Init::PerturbationPSFNoise(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][N
     for(int v   = NvLlD ; v   <= NvLuD ;   v++) {
 
       const double random_number = static_cast<double>(std::rand()) / RAND_MAX; // get random number [0,1]
-      f[s][m][z][y_k][x][v] += epsilon_0*(random_number-0.5e0) * f0[s][m][z][y_k][x][v];
+      f[s][m][z][y_k][x][v] += epsilon_0*(random_number-0.5e0) * f0[s][m][z][x][v];
 
     } } } } }
   }
 }   
 
-void Init::PerturbationPSFExp(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
-                                    CComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
+void Init::PerturbationPSFExp(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                    PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
 { 
   const double isGlobal = plasma->global ? 1. : 0.; 
   
@@ -187,15 +191,15 @@ void Init::PerturbationPSFExp(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvL
 
   for(int x = NxLlD; x <= NxLuD; x++) {  simd_for(int v = NvLlD; v <= NvLuD; v++) {
       
-    f[s][m][z][y_k][x][v] += f0[s][m][z][y_k][x][v] * 
+    f[s][m][z][y_k][x][v] += f0[s][m][z][x][v] * 
                          (isGlobal + species[s].n[x] * phase * Perturbation(x, z, epsilon_0, sigma)
                          * exp(-y_k*abs(sigma)*dky));
     
   } } } } } }
 }
 
-void Init::PerturbationPSFMode(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
-                                     CComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
+void Init::PerturbationPSFMode(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                     PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
 {
    // Calculates the phase (of what ??!)
    auto Phase = [=] (const int q, const int N)  -> double { return 2.*M_PI*((double) (q-1)/N); };
@@ -216,7 +220,7 @@ void Init::PerturbationPSFMode(const CComplex f0[NsLD][NmLB][NzLB][Nky][NxLB][Nv
         // for(int n = 1; n <= Nz/2; n++) pert_z +=  cos(n*(2.*M_PI*Z[z]/Lz)+Phase(n,Nz));
         // vlasov->f(x, y, z, RvLD, RmLD, s)  = (pre + (pert_x*pert_y*pert_z)) * vlasov->f0(x,y,z,RvLD, RmLD, s) / (Nx * Ny * Nz);
       
-        f[s][m][z][y_k][x][v] = epsilon_0 * (pert_x*pert_z) * f0[s][m][z][y_k][x][v] * (1./ (Nx * Nz));
+        f[s][m][z][y_k][x][v] = epsilon_0 * (pert_x*pert_z) * f0[s][m][z][x][v] * (1./ (Nx * Nz));
 
     }}} }}}
 }
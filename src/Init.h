@@ -57,8 +57,8 @@ class Init   : public IfaceGKC
   *
   **/
   void initBackground(Setup *setup, Grid *grid, 
-                      CComplex f0[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                      CComplex f [NsLD][NmLD][NzLB][Nky][NxLB][NvLB]);
+                      double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                      PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB]);
 
  public :
 
@@ -113,8 +113,8 @@ class Init   : public IfaceGKC
   *  
   * \f]
   **/ 
-  void PerturbationPSFMode(const CComplex f0[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                 CComplex f [NsLD][NmLD][NzLB][Nky][NxLB][NvLB]);
+  void PerturbationPSFMode(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                 PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB]);
 
   /**
   *   @brief Initialization of f1 using exponential
@@ -124,8 +124,8 @@ class Init   : public IfaceGKC
   *
   *   
   **/
-  void PerturbationPSFExp(const CComplex f0[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                CComplex f [NsLD][NmLD][NzLB][Nky][NxLB][NvLB]);
+  void PerturbationPSFExp(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB]);
 
   /**
   *   @brief Initialization of f1 using random noise
@@ -139,8 +139,8 @@ class Init   : public IfaceGKC
   *
   *
   **/
-  void PerturbationPSFNoise(const CComplex f0[NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-                                  CComplex f [NsLD][NmLD][NzLB][Nky][NxLB][NvLB]);
+  void PerturbationPSFNoise(const double   f0[NsLD][NmLB][NzLB]     [NxLB][NvLB],
+                                  PComplex f [NsLD][NmLB][NzLB][Nky][NxLB][NvLB]);
 
  protected:
 
@@ -71,8 +71,12 @@ Parallel::Parallel(Setup *setup)
   // Initialize MPI
   int provided = 0; 
   int required = numThreads == 1 ? MPI_THREAD_SINGLE : MPI_THREAD_SERIALIZED;
+
+  // asynchronous output calls MPI-IO from a background thread (see AsyncIO)
+  if(setup->get("DataOutput.Async", 0)) required = MPI_THREAD_MULTIPLE;
   
   MPI_Init_thread(&setup->argc, &setup->argv, required, &provided);
+  threadMultiple = (provided >= MPI_THREAD_MULTIPLE);
   //check(provided < required ? -1 : 1, DMESG("MPI : Thread level support not available (use only one thread)"));
 
   MPI_Comm_size(MPI_COMM_WORLD, &numProcesses); 
@@ -80,12 +84,7 @@ Parallel::Parallel(Setup *setup)
 
   //////////////////////// Set decomposition //////////////////////////////////
   
-  std::vector<std::string> decomp = Setup::split(setup->get("Parallel.Decomposition","Auto"), ":");
-
-  if(decomp.size() > 6) check(-1, DMESG("Decomposition only up to six dimensions"));
-
-  if(decomp[0] == "Auto")  getAutoDecomposition(numProcesses);
-  else for(int dir = DIR_X; dir < decomp.size() && (dir <= DIR_S); dir++) decomposition[dir] = std::stoi(decomp[dir]);
+  if(!readDecomposition(setup, decomposition)) getAutoDecomposition(numProcesses);
  
   checkValidDecomposition(setup);
    
@@ -185,13 +184,13 @@ Parallel::~Parallel()
  
 }
 
-void Parallel::updateBoundaryVlasov(CComplex *Sendu, CComplex *Sendl, CComplex *Recvu, CComplex  *Recvl, int num, int dir)
+void Parallel::updateBoundaryVlasov(PComplex *Sendu, PComplex *Sendl, PComplex *Recvu, PComplex  *Recvl, int num, int dir)
 { 
  // OPTIM : If we don't decompose,  copy Sendu->Recvl, .., without going through MPI
 
 #ifdef GKC_PARALLEL_MPI
      
-  auto mpi_type = getMPIDataType(typeid(CComplex)); 
+  auto mpi_type = getMPIDataType(typeid(PComplex)); 
 
   bool nonblocking = true;
    
@@ -227,6 +226,7 @@ void Parallel::updateBoundaryVlasovBarrier()
   //if(decomposition[DIR_X] > 1) MPI_Waitall(4, Talk[DIR_X].psf_msg_req, Talk[DIR_X].msg_status);
   if(Nz > 1) MPI_Waitall(4, Talk[DIR_Z].psf_msg_req, Talk[DIR_Z].msg_status);
   if(decomposition[DIR_V] > 1) MPI_Waitall(4, Talk[DIR_V].psf_msg_req, Talk[DIR_V].msg_status);
+  if(decomposition[DIR_M] > 1 && (NmLlD != NmLlB)) MPI_Waitall(4, Talk[DIR_M].psf_msg_req, Talk[DIR_M].msg_status);
       
 }
 
@@ -285,6 +285,7 @@ MPI_Datatype Parallel::getMPIDataType(const std::type_info &T)
 
   if     (T == typeid( Complex ) ) type = MPI_DOUBLE_COMPLEX;
   else if(T == typeid(CComplex ) ) type = MPI_DOUBLE_COMPLEX;
+  else if(T == typeid(_Complex float)) type = MPI_C_FLOAT_COMPLEX;
   else if(T == typeid(double   ) ) type = MPI_DOUBLE;
   else if(T == typeid(int      ) ) type = MPI_INT;
   else if(T == typeid(char     ) ) type = MPI_CHAR;
@@ -295,6 +296,19 @@ MPI_Datatype Parallel::getMPIDataType(const std::type_info &T)
   return type;
 }
 
+bool Parallel::readDecomposition(Setup *setup, int decomposition[6])
+{
+  std::vector<std::string> decomp = Setup::split(setup->get("Parallel.Decomposition","Auto"), ":");
+
+  if(decomp.size() > 6) check(-1, DMESG("Decomposition only up to six dimensions"));
+
+  if(decomp[0] == "Auto") return false;
+  
+  for(int dir = DIR_X; dir < decomp.size() && (dir <= DIR_S); dir++) decomposition[dir] = std::stoi(decomp[dir]);
+
+  return true;
+}
+
 void Parallel::getAutoDecomposition(int numCPU) 
 {
 
@@ -93,7 +93,8 @@ struct NeighbourDir {
       numProcesses;  ///< total number of MPI processes
    
   bool useOpenMP,    ///< true if compiled with OpenMP support
-       useMPI;       ///< true if compiled with MPI support
+       useMPI,       ///< true if compiled with MPI support
+       threadMultiple; ///< true if MPI can be called concurrently from several threads
 
   NeighbourDir Talk[DIR_S+1]; ///< Communication struct for Vlasov & Fields boundary
 
@@ -166,7 +167,7 @@ struct NeighbourDir {
   *    @params  dir    Direction to send data
   *
   **/
-  void updateBoundaryVlasov(CComplex *Sendu, CComplex *Sendl, CComplex *Recvu, CComplex  *Recvl, int num, int dir);
+  void updateBoundaryVlasov(PComplex *Sendu, PComplex *Sendl, PComplex *Recvu, PComplex  *Recvl, int num, int dir);
 
   /**
   *   
@@ -278,6 +279,18 @@ struct NeighbourDir {
   **/
   void   checkValidDecomposition(Setup *setup);
 
+  /**
+  *   @brief reads decomposition from Parallel.Decomposition (e.g. "2:1:4:1:1:1")
+  *
+  *   Directions which are not given are unchanged.
+  *
+  *   @param  setup          configuration parameters
+  *   @param  decomposition  decomposition (output)
+  *   @return false if automatic decomposition is requested
+  *
+  **/
+  static bool readDecomposition(Setup *setup, int decomposition[6]);
+
   /**
   *   @brief determines recommended decomposition 
   *
@@ -61,7 +61,7 @@ class Setup : public IfaceGKC {
   *   @brief flags defined from command line input
   *
   **/ 
-  enum GKCCmdLineFlags { GKC_STATISTICS=1, GKC_VERBOSE=2, GKC_OVERWRITE=4, GKC_READ_STDIN=8} ;
+  enum GKCCmdLineFlags { GKC_STATISTICS=1, GKC_VERBOSE=2, GKC_OVERWRITE=4, GKC_READ_STDIN=8, GKC_DRY_RUN=16} ;
  
   /**
   *    @brief Converts a number to std::string
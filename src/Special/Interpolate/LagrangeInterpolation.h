@@ -5,7 +5,7 @@
  *
  *    Description: One-dimensional Lagrangian interpolation
  *
- *         Author: Paul P. Hilscher (2012-), 
+ *         Author: Paul P. Hilscher (2012-),
  *
  *        License: GPLv3+
  * =====================================================================================
@@ -15,27 +15,95 @@
 #ifndef __LAGRANGEINTERPOALTION_H
 #define __LAGRANGEINTERPOALTION_H
 
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
 /**
  *  @brief Lagrangian interpolation class
  *
+ *  Pre-calculates the weights of the Lagrange polynomial of given order
+ *  (number of stencil points) from the source grid X (ascending, not
+ *  necessarily equidistant) to each target point Xi, thus
+ *
+ *  \f[ f(X_i) = \sum_{n=0}^{order-1} w_{i,n} f(X_{first_i + n}) \f]
+ *
+ *  The stencil is centered around the target point and shifted (one-sided)
+ *  at the boundaries of the source grid. Target points outside of the source
+ *  grid get zero weights unless extrapolation is allowed. For periodic grids
+ *  the stencil wraps around, thus source indices first_i + n have to be 
+ *  taken modulo N.
  *
  **/
-class LagrangeInterpolation 
+class LagrangeInterpolation
 {
+  int order;                   ///< number of stencil points
+
+  std::vector<int>    first;   ///< first source index of stencil of target point
+  std::vector<double> weight;  ///< weights [target point][order]
+
+ public:
+
+  /**
+  *   @brief Pre-calculate weights
+  *
+  *   @param X           source grid (ascending)
+  *   @param N           number of source points
+  *   @param Xi          target points
+  *   @param Ni          number of target points
+  *   @param _order      number of stencil points (e.g. 4 for cubic)
+  *   @param extrapolate if false, points outside of X are set to zero
+  *   @param period      period of the source grid (0 if not periodic)
+  *
+  **/
+  LagrangeInterpolation(const double *X, const int N, const double *Xi, const int Ni,
+                        const int _order=4, const bool extrapolate=false, const double period=0.)
+  : order(std::max(1, std::min(_order, N))), first(Ni), weight(Ni * order)
+  {
+    const bool periodic = (period > 0.);
 
+    // source point of (wrapped) index n
+    auto X_ = [=](const int n) -> double { 
+      const int q = ((n % N) + N) % N;
+      return X[q] + period * ((n - q) / N);
+    };
 
+    for(int i = 0; i < Ni; i++) {
 
+      // shift target point into first period of periodic grid
+      const double x = periodic ? X[0] + std::fmod(std::fmod(Xi[i] - X[0], period) + period, period) : Xi[i];
 
-  LagrangeInterpolation() {
+      // index of source interval [X[j], X[j+1]] containing x
+      const int j = int(std::upper_bound(X, X + N, x) - X) - 1;
 
+      first[i] = periodic ? j - (order-1)/2 : std::max(0, std::min(j - (order-1)/2, N - order));
 
+      const bool outside = !periodic && ((x < X[0]) || (x > X[N-1]));
 
+      for(int n = 0; n < order; n++) {
+
+        double w = (outside && !extrapolate) ? 0. : 1.;
+
+        for(int k = 0; k < order; k++) {
+
+          if(k != n) w *= (x - X_(first[i]+k)) / (X_(first[i]+n) - X_(first[i]+k));
+        }
+
+        weight[i * order + n] = w;
+      }
+    }
   };
 
+  /// number of stencil points
+  int getOrder() const { return order; };
+
+  /// first source index of stencil of target point i (may be outside of [0,N) for periodic grids)
+  int getFirst(const int i) const { return first[i]; };
 
+  /// weights of stencil of target point i
+  const double* getWeights(const int i) const { return &weight[i * order]; };
 
 };
 
 
 #endif // __LAGRANGEINTERPOALTION_H
-
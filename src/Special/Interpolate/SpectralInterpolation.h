@@ -0,0 +1,87 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: SpectralInterpolation.h
+ *
+ *    Description: One-dimensional spectral (trigonometric) interpolation
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+
+#ifndef __SPECTRALINTERPOLATION_H
+#define __SPECTRALINTERPOLATION_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/**
+ *  @brief Spectral interpolation between periodic grids
+ *
+ *  Interpolates a periodic function given on N equidistant points 
+ *  \f$ X_j = X_0 + j \Delta X \f$ (period \f$ N \Delta X \f$) to arbitrary target
+ *  points \f$ x_i \f$. For an equidistant target grid of the same period this is
+ *  equivalent to zero-padding or truncation of its Fourier modes. The 
+ *  interpolation is calculated as a matrix product with the (real) weights
+ *
+ *  \f[ W_{ij} = \frac{1}{N} \sum_{k=-K}^{K} c_k \cos\left(\frac{2\pi k}{N} (t_i - j)\right) \f]
+ *
+ *  where \f$ t_i = (x_i - X_0) / \Delta X \f$ is the target point in units of
+ *  the source grid, \f$ K = \min(N,N_i)/2 \f$ and \f$ c_{\pm K} = 1/2 \f$ for the Nyquist
+ *  mode of even numbers (otherwise 1). Thus no FFT library is required, and
+ *  only the rows of local target points need to be calculated. For identical
+ *  grids the weights reduce to the identity, a shift of the grids (e.g. 
+ *  Grid.IncludeX0Point) is taken into account by the target coordinates.
+ *
+ **/
+class SpectralInterpolation
+{
+  int N;                     ///< number of source points
+
+  std::vector<double> W;     ///< weights [target point][source point]
+
+ public:
+
+  /**
+  *   @brief Pre-calculate weights
+  *
+  *   @param _N   number of source points
+  *   @param X0   first source point
+  *   @param dX   spacing of source points
+  *   @param Ni   number of (global) target points, determines resolved modes
+  *   @param Xi   target points to calculate
+  *   @param num  number of target points to calculate
+  *
+  **/
+  SpectralInterpolation(const int _N, const double X0, const double dX, const int Ni, const double *Xi, const int num)
+  : N(_N), W(num * _N)
+  {
+    const int    M = std::min(N, Ni);
+    const int    K = M / 2;
+
+    for(int i = 0; i < num; i++) { for(int j = 0; j < N; j++) {
+
+      const double t = (Xi[i] - X0) / dX - j;
+
+      double w = 1.;
+      for(int k = 1; k <= K; k++) {
+
+        const double c = ((M % 2 == 0) && (k == K)) ? 0.5 : 1.;
+        w += 2. * c * std::cos(2. * M_PI * k * t / N);
+      }
+
+      W[i * N + j] = w / N;
+    } }
+  };
+
+  /// weights of target point Xi[i]
+  const double* getWeights(const int i) const { return &W[i * N]; };
+
+};
+
+
+#endif // __SPECTRALINTERPOLATION_H
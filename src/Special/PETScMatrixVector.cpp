@@ -52,8 +52,8 @@ PetscErrorCode PETScMatrixVector::MatrixVectorProduct(Mat A, Vec Vec_x, Vec Vec_
   if(control_triggered_signal) petsc_signal_handler(control_triggered_signal, nullptr);
 
 
-  [=] (CComplex  fs [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],  
-       CComplex  fss[NsLD][NmLD][NzLB][Nky][NxLB][NvLB])
+  [=] (PComplex  fs [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],  
+       PComplex  fss[NsLD][NmLB][NzLB][Nky][NxLB][NvLB])
   {
       
     if(process_rank == 0 ) std::cout << "\r"   << "Iteration  : " << GL_iter++ << std::flush;
@@ -103,7 +103,7 @@ PetscErrorCode PETScMatrixVector::MatrixVectorProduct(Mat A, Vec Vec_x, Vec Vec_
     VecRestoreArrayRead(Vec_x, (const PetscScalar **) &x_F1);
     VecRestoreArray    (Vec_y, (      PetscScalar **) &y_F1);
 
-    } ((A6zz) GL_vlasov->fs, (A6zz) GL_vlasov->fss);
+    } ((A6pp) GL_vlasov->fs, (A6pp) GL_vlasov->fss);
    
   return 0; // return 0 (success) required for PETSc
 
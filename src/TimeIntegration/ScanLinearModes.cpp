@@ -35,8 +35,9 @@ ScanLinearModes::ScanLinearModes(Setup *setup, Grid *grid, Parallel *_parallel,
 
 ScanLinearModes::~ScanLinearModes()
 {
-  H5Gclose(scanGroupID);
+  // table flushes buffered records to group, thus delete before closing it
   delete freqTable;
+  H5Gclose(scanGroupID);
 }
 
 
@@ -61,8 +62,8 @@ void ScanLinearModes::solve(Vlasov *vlasov, Fields *fields, TimeIntegration *tim
     // Note : don't screen out Nyquist and ZF ! 
     timeIntegration->setMaxLinearTimeStep(eigenvalue, vlasov, fields);
   
-    //init->PerturbationPSFNoise((A6zz) vlasov->f0, (A6zz) vlasov->f);
-    init->PerturbationPSFExp((A6zz) vlasov->f0, (A6zz) vlasov->f);
+    //init->PerturbationPSFNoise((A5rr) vlasov->f0, (A6pp) vlasov->f);
+    init->PerturbationPSFExp((A5rr) vlasov->f0, (A6pp) vlasov->f);
     
     ErrorVals w_im(5), w_re(5);
 
@@ -109,14 +109,14 @@ void ScanPoloidalEigen::getPerturbations(int y_k_, Timing timing)
 {
   
   ///////////  Set current value of f1 ////////////////////
-  [=](CComplex f[NsLD][NmLD][NzLB][Nky][NxLB][NvLB]) {
+  [=](PComplex f[NsLD][NmLB][NzLB][Nky][NxLB][NvLB]) {
 
     for(int x = NxLlD, n = 0; x <= NxLuD; x++) { for(int v = NvLlD; v <= NvLuD; v++, n++) {
 
       Eigvec_y.SetLocal(n, 0, C(f[NsLlD][NmLlD][NzLlD][y_k_][x][v]));
     } }
 
-  } ((A6zz) vlasov->f);
+  } ((A6pp) vlasov->f);
 
   ///////////// Solve using inverse matrix x = A^-1 y /////////////////////
   elem::Gemv(elem::NORMAL, C(1.), Mat_Eigvec_ky, Eigvec_y, C(0.), Eigvec_x);
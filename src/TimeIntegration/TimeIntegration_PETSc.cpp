@@ -45,7 +45,7 @@ TimeIntegration_PETSc::TimeIntegration_PETSc(Setup *setup, Grid *grid, Parallel
   CComplex *init_x = PETScMatrixVector::getCreateVector(grid, Vec_init);
   
   // Set initial condition
-  [=](const CComplex f[NsLD][NmLD][NzLB][NkyLD][NxLB][NvLB]) {
+  [=](const PComplex f[NsLD][NmLB][NzLB][NkyLD][NxLB][NvLB]) {
   
     int n = 0;
 
@@ -57,7 +57,7 @@ TimeIntegration_PETSc::TimeIntegration_PETSc(Setup *setup, Grid *grid, Parallel
 
     }}} }}}
       
-  }((A6zz) vlasov->f);
+  }((A6pp) vlasov->f);
 
   VecRestoreArray(Vec_init, (PetscScalar **) &init_x);
   TSSetSolution(ts, Vec_init);
@@ -87,7 +87,7 @@ double TimeIntegration_PETSc::solveTimeStep(Vlasov *vlasov, Fields *fields, Test
 
   // copy whole phase space function (waste but starting point) (important due to boundary conditions
   // we can built wrapper around this and directly pass it
-  [=](CComplex f[NsLD][NmLD][NzLB][NkyLD][NxLB][NvLB]) {
+  [=](PComplex f[NsLD][NmLB][NzLB][NkyLD][NxLB][NvLB]) {
     
     int n = 0;
     for(int s = NsLlD; s <= NsLuD; s++) { for(int m   = NmLlD ; m   <= NmLuD ; m++  ) { 
@@ -98,7 +98,7 @@ double TimeIntegration_PETSc::solveTimeStep(Vlasov *vlasov, Fields *fields, Test
 
     } } }  } } }
       
-  }((A6zz) vlasov->f);
+  }((A6pp) vlasov->f);
            
   fields->solve(vlasov->f0,  vlasov->f); 
   VecRestoreArray    (Vec_F1, (PetscScalar **) &x_F1);
@@ -0,0 +1,203 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: RawSnapshot.h
+ *
+ *    Description: Raw (per-process) memory-mapped snapshots of the phase space
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef __GKC_RAW_SNAPSHOT_H__
+#define __GKC_RAW_SNAPSHOT_H__
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+*
+*   @brief Raw snapshot of local phase-space block
+*
+*   For fast checkpoints (e.g. before preemption) each process writes its
+*   local arrays (f0 and f1 including boundaries) to a separate binary file
+*   <prefix>.<rank>.raw without HDF-5 or any collective operation. Data is
+*   copied into a memory map of the file and synced by msync. The file is
+*   first written under a temporary name and then renamed, thus an existing
+*   snapshot is only replaced by a complete one.
+*
+*   The header stores the layout of each array in the same way as FileAttr
+*   (global dimensions, memory (boundary) dimensions, domain dimensions,
+*   memory and file offset), thus the converter (gkc-raw2h5) can reassemble
+*   the snapshots into the /Vlasov/f0 and /Vlasov/f1 datasets of the HDF-5
+*   output without knowledge of the decomposition. Additionally the (equidistant)
+*   grid is stored, which is written to /Grid for interpolated restarts.
+*
+*   Layout : [ Header (4096 bytes) | Array 0 | Array 1 | ... ]
+*
+**/
+namespace RawSnapshot {
+
+  const char   Magic[8]    = "GKCRAW2";
+  const size_t HeaderBytes = 4096;      ///< size of header (keeps data page-aligned)
+  const int    MaxArrays   = 2;         ///< number of arrays (f0, f1)
+
+  /// Layout of array in file (see FileAttr)
+  struct Layout {
+    char     name[16]; ///< dataset name (e.g. "f1")
+    uint32_t ndim;     ///< number of dimensions (including time)
+    uint32_t elemSize; ///< bytes per element (e.g. sizeof(PComplex))
+    uint32_t isComplex;///< 1 if element is complex (r,i), 0 if real
+    uint32_t reserved; ///< unused (no padding, layouts are compared bytewise)
+    uint64_t dim [7],  ///< global dataset dimensions
+             bdim[7],  ///< memory dimensions (including boundaries)
+             cdim[7],  ///< domain dimensions (written part)
+             moff[7],  ///< offset of domain in memory
+             off [7];  ///< offset of domain in global dataset
+    uint64_t offset,   ///< offset of data in file (bytes)
+             bytes;    ///< size of data (bytes)
+  };
+
+  /// Equidistant grids X, Z, V (i-th point is X0 + i dx), written by gkc-raw2h5 to /Grid
+  struct GridInfo {
+    double Lx, Ly, Lz,  ///< domain lengths
+           X0, dx,      ///< first point and spacing in x
+           Z0, dz,      ///< first point and spacing in z
+           V0, dv;      ///< first point and spacing in v
+  };
+
+  /// File header
+  struct Header {
+    char     magic[8];          ///< "GKCRAW2"
+    int32_t  rank,              ///< MPI rank of writing process
+             numProcesses,      ///< total number of processes
+             decomposition[6],  ///< decomposition (x,y,z,v,m,s)
+             timestep;          ///< time step of snapshot
+    double   time;              ///< time of snapshot
+    GridInfo grid;              ///< grid (number of points given by dimensions of f1)
+    uint32_t numArrays;         ///< number of arrays in file
+    Layout   array[MaxArrays];  ///< array layouts
+  };
+
+  /**
+  *   @brief file name of process
+  *
+  **/
+  inline std::string getFileName(const std::string prefix, const int rank)
+  {
+    return prefix + "." + std::to_string(rank) + ".raw";
+  };
+
+  /**
+  *   @brief get number of bytes from memory dimensions and set file offsets
+  *
+  **/
+  inline void setOffsets(Header &header)
+  {
+    uint64_t offset = HeaderBytes;
+
+    for(uint32_t n = 0; n < header.numArrays; n++) {
+
+      Layout &a = header.array[n];
+
+      // last dimension is time (not stored)
+      a.bytes = a.elemSize;
+      for(uint32_t d = 0; d < a.ndim-1; d++) a.bytes *= a.bdim[d];
+
+      a.offset = offset;
+      offset  += a.bytes;
+    }
+  };
+
+  /**
+  *   @brief write snapshot to file using mmap/msync
+  *
+  *   @param name   file name
+  *   @param header header (with offsets set by setOffsets)
+  *   @param data   pointer to arrays
+  *
+  *   @return true on success
+  *
+  **/
+  inline bool write(const std::string name, Header header, const void *data[])
+  {
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    setOffsets(header);
+
+    const Layout &last = header.array[header.numArrays-1];
+    const size_t  size = last.offset + last.bytes;
+
+    const std::string tmpName = name + ".tmp";
+
+    const int fd = open(tmpName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) return false;
+
+    if(ftruncate(fd, size) != 0) { close(fd); return false; }
+
+    char *map = (char *) mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(map == MAP_FAILED) { close(fd); return false; }
+
+    std::memcpy(map, &header, sizeof(Header));
+    for(uint32_t n = 0; n < header.numArrays; n++) std::memcpy(map + header.array[n].offset, data[n], header.array[n].bytes);
+
+    const bool ok = (msync(map, size, MS_SYNC) == 0);
+
+    munmap(map, size);
+    close(fd);
+
+    // replace previous snapshot only by a complete one
+    return ok && (rename(tmpName.c_str(), name.c_str()) == 0);
+  };
+
+  /**
+  *   @brief map snapshot file (read-only)
+  *
+  *   @param name   file name
+  *   @param header header of file (output)
+  *   @param size   size of mapping (output, required for munmap)
+  *
+  *   @return pointer to mapping, or nullptr on failure
+  *
+  **/
+  inline const char* map(const std::string name, Header &header, size_t &size)
+  {
+    const int fd = open(name.c_str(), O_RDONLY);
+    if(fd < 0) return nullptr;
+
+    struct stat st;
+    if((fstat(fd, &st) != 0) || (size_t(st.st_size) < HeaderBytes)) { close(fd); return nullptr; }
+
+    size = st.st_size;
+    const char *map = (const char *) mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(map == MAP_FAILED) return nullptr;
+
+    std::memcpy(&header, map, sizeof(Header));
+
+    if((std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) || (header.numArrays > MaxArrays)) {
+      munmap((void *) map, size);
+      return nullptr;
+    }
+
+    return map;
+  };
+
+  /**
+  *   @brief unmap snapshot
+  *
+  **/
+  inline void unmap(const char *map, size_t size) { munmap((void *) map, size); };
+
+} // namespace RawSnapshot
+
+#endif // __GKC_RAW_SNAPSHOT_H__
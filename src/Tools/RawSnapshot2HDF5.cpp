@@ -0,0 +1,200 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: RawSnapshot2HDF5.cpp
+ *
+ *    Description: Converts raw per-process snapshots into HDF-5 (gkc-raw2h5)
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hdf5.h"
+#include "hdf5_hl.h"
+
+#include "Tools/RawSnapshot.h"
+
+/**
+*   @brief Program starting point of gkc-raw2h5
+*
+*   Reassembles the raw snapshots <prefix>.<rank>.raw of all processes
+*   (see RawSnapshot) into /Vlasov/f0 and /Vlasov/f1 of a new HDF-5 file,
+*   with the same layout as the gkc output, thus it can be used as
+*   input file for a restart with any decomposition. The grid is written
+*   to /Grid (as Grid::initData), thus resolution may change as well.
+*
+*   Usage : gkc-raw2h5 <prefix> <output.h5>
+*
+**/
+int main(int argc, char **argv)
+{
+  if(argc != 3) {
+    std::cerr << "Usage : " << argv[0] << " <prefix> <output.h5>" << std::endl;
+    return 1;
+  }
+
+  const std::string prefix(argv[1]), outputFileName(argv[2]);
+
+  // get number of processes from rank 0
+  RawSnapshot::Header header0;
+  size_t size0;
+  const char *map0 = RawSnapshot::map(RawSnapshot::getFileName(prefix, 0), header0, size0);
+
+  if(map0 == nullptr) {
+    std::cerr << "Cannot read " << RawSnapshot::getFileName(prefix, 0) << std::endl;
+    return 1;
+  }
+  RawSnapshot::unmap(map0, size0);
+
+  hid_t file = H5Fcreate(outputFileName.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+  if(file < 0) { std::cerr << "Cannot create " << outputFileName << std::endl; return 1; }
+
+  hid_t group = H5Gcreate(file, "/Vlasov", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+  // data types (same as FileIO, names r and i are required by pyTables)
+  std::vector<hid_t> types, datasets;
+
+  for(uint32_t n = 0; n < header0.numArrays; n++) {
+
+    const RawSnapshot::Layout &a = header0.array[n];
+
+    hid_t base = (a.elemSize / (a.isComplex ? 2 : 1) == 4) ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+    hid_t type = H5Tcopy(base);
+
+    if(a.isComplex) {
+      H5Tclose(type);
+      type = H5Tcreate(H5T_COMPOUND, a.elemSize);
+      H5Tinsert(type, "r", 0              , base);
+      H5Tinsert(type, "i", a.elemSize / 2 , base);
+    }
+
+    hsize_t dim[7], mdim[7];
+    for(uint32_t d = 0; d < a.ndim; d++) { dim[d] = a.dim[d]; mdim[d] = a.dim[d]; }
+    mdim[a.ndim-1] = H5S_UNLIMITED;
+
+    hsize_t cdim[7];
+    for(uint32_t d = 0; d < a.ndim; d++) cdim[d] = a.cdim[d];
+
+    hid_t dspace = H5Screate_simple(a.ndim, dim, mdim);
+    hid_t dcpl   = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(dcpl, a.ndim, cdim);
+
+    datasets.push_back(H5Dcreate2(group, a.name, type, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT));
+    types.push_back(type);
+
+    H5Pclose(dcpl);
+    H5Sclose(dspace);
+  }
+
+  // write local domain of each process
+  for(int rank = 0; rank < header0.numProcesses; rank++) {
+
+    RawSnapshot::Header header;
+    size_t size;
+    const std::string name = RawSnapshot::getFileName(prefix, rank);
+    const char *map = RawSnapshot::map(name, header, size);
+
+    if((map == nullptr) || (header.numProcesses != header0.numProcesses) || (header.timestep != header0.timestep)) {
+      std::cerr << "Cannot read " << name << " (or snapshot is inconsistent with rank 0)" << std::endl;
+      return 1;
+    }
+
+    for(uint32_t n = 0; n < header.numArrays; n++) {
+
+      const RawSnapshot::Layout &a = header.array[n];
+
+      hsize_t bdim[7], cdim[7], moff[7], off[7];
+      for(uint32_t d = 0; d < a.ndim; d++) { bdim[d] = a.bdim[d]; cdim[d] = a.cdim[d]; moff[d] = a.moff[d]; off[d] = a.off[d]; }
+
+      hid_t mspace = H5Screate_simple(a.ndim, bdim, NULL);
+      H5Sselect_hyperslab(mspace, H5S_SELECT_SET, moff, NULL, cdim, NULL);
+
+      hid_t dspace = H5Dget_space(datasets[n]);
+      H5Sselect_hyperslab(dspace, H5S_SELECT_SET, off, NULL, cdim, NULL);
+
+      if(H5Dwrite(datasets[n], types[n], mspace, dspace, H5P_DEFAULT, map + a.offset) < 0) {
+        std::cerr << "Cannot write " << a.name << " of " << name << std::endl;
+        return 1;
+      }
+
+      H5Sclose(dspace);
+      H5Sclose(mspace);
+    }
+
+    RawSnapshot::unmap(map, size);
+  }
+
+  // time of snapshot (same compound type as FileIO timing)
+  {
+    hid_t timing_tid = H5Tcreate(H5T_COMPOUND, sizeof(int32_t) + sizeof(double));
+    H5Tinsert(timing_tid, "Timestep", 0              , H5T_NATIVE_INT   );
+    H5Tinsert(timing_tid, "Time"    , sizeof(int32_t), H5T_NATIVE_DOUBLE);
+    H5Tpack(timing_tid);
+
+    struct { int32_t step; double time; } timing = { header0.timestep, header0.time };
+
+    hid_t mtype = H5Tcreate(H5T_COMPOUND, sizeof(timing));
+    H5Tinsert(mtype, "Timestep", HOFFSET(decltype(timing), step), H5T_NATIVE_INT   );
+    H5Tinsert(mtype, "Time"    , HOFFSET(decltype(timing), time), H5T_NATIVE_DOUBLE);
+
+    hsize_t dim[1] = { 1 }, mdim[1] = { H5S_UNLIMITED };
+    hid_t dspace = H5Screate_simple(1, dim, mdim);
+    hid_t dcpl   = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(dcpl, 1, dim);
+
+    hid_t dataset = H5Dcreate2(group, "Time", timing_tid, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    H5Dwrite(dataset, mtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, &timing);
+
+    H5Dclose(dataset); H5Pclose(dcpl); H5Sclose(dspace);
+    H5Tclose(mtype); H5Tclose(timing_tid);
+  }
+
+  // grid (number of points from f1 [s][m][z][k_y][x][v][t]), as required for interpolation
+  {
+    const RawSnapshot::GridInfo &g  = header0.grid;
+    const RawSnapshot::Layout   &f1 = header0.array[1];
+
+    const int Ns = f1.dim[0], Nm = f1.dim[1], Nz = f1.dim[2], Nky = f1.dim[3], Nx = f1.dim[4], Nv = f1.dim[5];
+
+    std::vector<double> X(Nx), Z(Nz), V(Nv);
+    for(int x = 0; x < Nx; x++) X[x] = g.X0 + x * g.dx;
+    for(int z = 0; z < Nz; z++) Z[z] = g.Z0 + z * g.dz;
+    for(int v = 0; v < Nv; v++) V[v] = g.V0 + v * g.dv;
+
+    hid_t gridGroup = H5Gcreate(file, "/Grid", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    H5LTset_attribute_double(gridGroup, ".", "Lx", &g.Lx, 1);
+    H5LTset_attribute_double(gridGroup, ".", "Ly", &g.Ly, 1);
+    H5LTset_attribute_double(gridGroup, ".", "Lz", &g.Lz, 1);
+
+    H5LTset_attribute_int(gridGroup, ".", "Nx" , &Nx , 1);
+    H5LTset_attribute_int(gridGroup, ".", "Nky", &Nky, 1);
+    H5LTset_attribute_int(gridGroup, ".", "Nz" , &Nz , 1);
+    H5LTset_attribute_int(gridGroup, ".", "Nv" , &Nv , 1);
+    H5LTset_attribute_int(gridGroup, ".", "Nm" , &Nm , 1);
+    H5LTset_attribute_int(gridGroup, ".", "Ns" , &Ns , 1);
+
+    H5LTset_attribute_double(gridGroup, ".", "X", X.data(), Nx);
+    H5LTset_attribute_double(gridGroup, ".", "Z", Z.data(), Nz);
+    H5LTset_attribute_double(gridGroup, ".", "V", V.data(), Nv);
+
+    H5Gclose(gridGroup);
+  }
+
+  for(auto dataset : datasets) H5Dclose(dataset);
+  for(auto type    : types   ) H5Tclose(type);
+
+  H5Gclose(group);
+  H5Fclose(file);
+
+  std::cout << "Converted snapshot of " << header0.numProcesses << " processes (time step "
+            << header0.timestep << ") to " << outputFileName << std::endl;
+
+  return 0;
+}
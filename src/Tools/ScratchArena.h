@@ -0,0 +1,145 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: ScratchArena.h
+ *
+ *    Description: Per-thread memory arena for large temporary arrays
+ *
+ *         Author: Paul P. Hilscher (2013),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef __GKC_SCRATCH_ARENA_H__
+#define __GKC_SCRATCH_ARENA_H__
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include <xmmintrin.h>
+
+/**
+*
+*   @brief Per-thread scratch memory for temporary arrays
+*
+*   Large temporary arrays (e.g. for the non-linearity or moments) were
+*   declared as VLAs on the stack, which requires large OMP_STACKSIZE and
+*   ulimit -s settings and fails for large grids. Instead, these arrays are
+*   taken from a thread-local arena, which is allocated once (64 bytes aligned)
+*   and reused across calls, thus it stays in cache similar to stack memory.
+*
+*   Memory is allocated by a bump pointer and released in stack order
+*   using a Frame, e.g.
+*
+*   \code
+*      ScratchArena::Frame frame;
+*      doubleAA (*xy_f1)[NxLB] = (doubleAA (*)[NxLB]) ScratchArena::get<double>((NyLD+4) * NxLB);
+*   \endcode
+*
+*   As with stack variables, memory is not initialized and each thread has
+*   its own arena (thread_local). Pointers stay valid until the Frame is
+*   destroyed, as the arena grows by adding blocks (and never reallocates).
+*
+**/
+class ScratchArena
+{
+
+  static const size_t Alignment = 64;          ///< alignment of arrays (cache-line)
+  static const size_t BlockSize = 16 << 20;    ///< minimum size of a block (16 MB)
+
+  /// Memory block of arena
+  struct Block {
+    char   *data; ///< pointer to memory
+    size_t  size; ///< size of block in bytes
+  };
+
+  std::vector<Block> blocks; ///< allocated blocks
+
+  size_t block,  ///< current block
+         offset; ///< offset in current block
+
+  ScratchArena() : block(0), offset(0) {};
+
+ ~ScratchArena()
+  {
+    for(auto &b : blocks) _mm_free(b.data);
+  };
+
+  /**
+  *   @brief get arena of calling thread
+  *
+  **/
+  static ScratchArena& local()
+  {
+    static thread_local ScratchArena arena;
+    return arena;
+  };
+
+  /**
+  *   @brief allocate bytes from the arena
+  *
+  **/
+  void *allocate(size_t bytes)
+  {
+    // round up to keep alignment of next allocation
+    bytes = (bytes + Alignment - 1) / Alignment * Alignment;
+
+    // use next block which is large enough
+    for( ; block < blocks.size(); block++, offset = 0) {
+
+      if(offset + bytes <= blocks[block].size) {
+
+        void *ptr = blocks[block].data + offset;
+        offset += bytes;
+        return ptr;
+      }
+    }
+
+    // need a new block
+    const size_t size = std::max(bytes, BlockSize);
+    blocks.push_back({ (char *) _mm_malloc(size, Alignment), size });
+
+    block  = blocks.size() - 1;
+    offset = bytes;
+
+    return blocks[block].data;
+  };
+
+ public:
+
+  /**
+  *   @brief Allocate num elements of type T from thread-local arena
+  *
+  *   @param num number of elements
+  *
+  *   @return aligned pointer, valid until enclosing Frame is destroyed
+  *
+  **/
+  template<class T> static T* get(size_t num)
+  {
+    return (T *) local().allocate(num * sizeof(T));
+  };
+
+  /**
+  *   @brief Scope of scratch arrays
+  *
+  *   All memory taken from the thread-local arena after construction
+  *   of the frame is released again when the frame goes out of scope.
+  *
+  **/
+  class Frame
+  {
+    ScratchArena &arena;
+    size_t block, offset;
+
+   public:
+
+    Frame() : arena(ScratchArena::local()), block(arena.block), offset(arena.offset) {};
+   ~Frame() { arena.block = block; arena.offset = offset; };
+  };
+
+};
+
+#endif // __GKC_SCRATCH_ARENA_H__
@@ -0,0 +1,281 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: Telemetry.h
+ *
+ *    Description: Live telemetry of scalar values in a shared-memory ring buffer
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef __GKC_TELEMETRY_H__
+#define __GKC_TELEMETRY_H__
+
+#include <string>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include <cerrno>
+#include <csignal>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+*
+*   @brief Live telemetry of scalar values (energies, fluxes, timings)
+*
+*   For monitoring of running simulations without opening the HDF-5 output,
+*   the master process publishes each output of the scalar values (see
+*   Diagnostics) into a ring buffer in a POSIX shared-memory segment
+*   (/dev/shm), which can be read by any number of readers (gkc-telemetry)
+*   on the same node.
+*
+*   There is a single producer which never waits for readers. Each slot
+*   carries a sequence number (odd while being written, 2(n+1) after
+*   record n was written), thus a reader detects if a record was overwritten
+*   while being copied (seqlock). Readers which fall behind by more than the
+*   capacity lose the oldest records.
+*
+*   Layout : [ Header | Slot 0 | Slot 1 | ... | Slot capacity-1 ]
+*
+**/
+namespace Telemetry {
+
+  const char Magic[8]   = "GKCTLM1";
+  const int  MaxSpecies = 16;  ///< maximum number of species (see SPECIES_MAX)
+  const int  MaxFields  = 3;   ///< maximum number of fields (φ, A∥, B∥)
+  const int  MaxStages  = 16;  ///< maximum number of timed stages
+
+  /// Measured wall time of a scheduled diagnostic (see Scheduler), the time integration 
+  /// is not split into stages (its cost is included in Record::stepTime)
+  struct Stage {
+    char   name[24];   ///< name of stage
+    double cost;       ///< wall time in seconds (averaged, maximum over processes)
+  };
+
+  /// Published record (layout of fluxes as in ScalarValues [s][q])
+  struct Record {
+    int32_t timestep,                                ///< time step
+            numStages;                               ///< number of valid stages
+    double  walltime,                                ///< wall clock time since start
+            time,                                    ///< simulation time
+            dt,                                      ///< time step size
+            stepTime,                                ///< mean wall time per time step since last record
+            phiEnergy,                               ///< electric field energy
+            ApEnergy,                                ///< magnetic field energy (A∥)
+            BpEnergy;                                ///< magnetic field energy (B∥)
+    double  particle_number[MaxSpecies],             ///< total particle number
+            kinetic_energy [MaxSpecies],             ///< total kinetic energy
+            entropy        [MaxSpecies],             ///< total entropy
+            heat_flux      [MaxSpecies * MaxFields], ///< total heat flux
+            particle_flux  [MaxSpecies * MaxFields]; ///< total particle flux
+    Stage   stage[MaxStages];                        ///< timings of stages
+  };
+
+  /// Slot of ring buffer
+  struct Slot {
+    std::atomic<uint64_t> seq;    ///< sequence number (odd while written)
+    Record                record; ///< published record
+  };
+
+  /// Header of segment
+  struct Header {
+    char     magic[8];                     ///< "GKCTLM1"
+    uint32_t recordBytes,                  ///< sizeof(Record) (consistency check)
+             capacity;                     ///< number of slots
+    int32_t  pid,                          ///< process id of producer
+             numSpecies,                   ///< number of species
+             numFields;                    ///< number of fields
+    char     species[MaxSpecies][16];      ///< species names
+
+    alignas(64) std::atomic<uint64_t> head; ///< number of published records
+  };
+
+  /**
+  *   @brief size of segment in bytes
+  *
+  **/
+  inline size_t getBytes(const uint32_t capacity) { return sizeof(Header) + capacity * sizeof(Slot); };
+
+  /**
+  *   @brief slots of ring buffer
+  *
+  **/
+  inline Slot* getSlots(Header *ring) { return (Slot *) ((char *) ring + sizeof(Header)); };
+  inline const Slot* getSlots(const Header *ring) { return (const Slot *) ((const char *) ring + sizeof(Header)); };
+
+  /**
+  *   @brief segment name (POSIX requires a leading slash)
+  *
+  **/
+  inline std::string getSegmentName(const std::string name)
+  {
+    return (name.size() > 0 && name[0] == '/') ? name : "/" + name;
+  };
+
+  inline const Header* map(const std::string name);
+  inline void unmap(const Header *ring, const std::string name, const bool remove);
+
+  /**
+  *   @brief create segment (producer)
+  *
+  *   An existing segment is only replaced if its producer is no longer
+  *   running (e.g. left over from a crashed run), otherwise it fails.
+  *
+  *   @param name       segment name
+  *   @param capacity   number of slots
+  *   @param numSpecies number of species
+  *   @param numFields  number of fields
+  *   @param names      species names
+  *
+  *   @return pointer to mapping, or nullptr on failure (or segment in use)
+  *
+  **/
+  inline Header* create(const std::string name, const uint32_t capacity, const int numSpecies, const int numFields,
+                        const std::string names[])
+  {
+    const std::string segment = getSegmentName(name);
+    const size_t      size    = getBytes(capacity);
+
+    // segment exists, fail if used by a running producer (existence check by signal 0)
+    const Header *old = map(name);
+
+    if(old != nullptr) {
+
+      const pid_t pid = old->pid;
+      unmap(old, name, false);
+
+      if((kill(pid, 0) == 0) || (errno != ESRCH)) return nullptr;
+    }
+
+    shm_unlink(segment.c_str());
+
+    const int fd = shm_open(segment.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if(fd < 0) return nullptr;
+
+    if(ftruncate(fd, size) != 0) { ::close(fd); shm_unlink(segment.c_str()); return nullptr; }
+
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(map == MAP_FAILED) { shm_unlink(segment.c_str()); return nullptr; }
+
+    // segment is zero-filled, thus all slots are empty (seq = 0)
+    Header *ring = new (map) Header;
+
+    ring->recordBytes = sizeof(Record);
+    ring->capacity    = capacity;
+    ring->pid         = getpid();
+    ring->numSpecies  = numSpecies;
+    ring->numFields   = numFields;
+
+    for(int s = 0; s < numSpecies; s++) std::strncpy(ring->species[s], names[s].c_str(), sizeof(ring->species[s]) - 1);
+
+    ring->head.store(0, std::memory_order_relaxed);
+
+    for(uint32_t n = 0; n < capacity; n++) new (&getSlots(ring)[n].seq) std::atomic<uint64_t>(0);
+
+    // magic is set last, thus readers never see a partially initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(ring->magic, Magic, sizeof(Magic));
+
+    return ring;
+  };
+
+  /**
+  *   @brief publish record (single producer, never blocks)
+  *
+  **/
+  inline void publish(Header *ring, const Record &record)
+  {
+    const uint64_t n    = ring->head.load(std::memory_order_relaxed);
+    Slot          &slot = getSlots(ring)[n % ring->capacity];
+
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&slot.record, &record, sizeof(Record));
+
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    ring->head.store(n + 1, std::memory_order_release);
+  };
+
+  /**
+  *   @brief map existing segment (read-only, reader)
+  *
+  *   @param name segment name
+  *
+  *   @return pointer to mapping, or nullptr on failure
+  *
+  **/
+  inline const Header* map(const std::string name)
+  {
+    const int fd = shm_open(getSegmentName(name).c_str(), O_RDONLY, 0);
+    if(fd < 0) return nullptr;
+
+    struct stat st;
+    if((fstat(fd, &st) != 0) || (size_t(st.st_size) < sizeof(Header))) { ::close(fd); return nullptr; }
+
+    const size_t size = st.st_size;
+    const void *segment = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(segment == MAP_FAILED) return nullptr;
+
+    const Header *ring = (const Header *) segment;
+
+    if((std::memcmp(ring->magic, Magic, sizeof(Magic)) != 0) || (ring->recordBytes != sizeof(Record)) ||
+       (getBytes(ring->capacity) > size)) {
+      munmap((void *) segment, size);
+      return nullptr;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return ring;
+  };
+
+  /**
+  *   @brief number of published records
+  *
+  **/
+  inline uint64_t getHead(const Header *ring) { return ring->head.load(std::memory_order_acquire); };
+
+  /**
+  *   @brief copy record n
+  *
+  *   @return false if record is not available (not yet written or overwritten)
+  *
+  **/
+  inline bool read(const Header *ring, const uint64_t n, Record &record)
+  {
+    const Slot &slot = getSlots(ring)[n % ring->capacity];
+
+    if(slot.seq.load(std::memory_order_acquire) != 2 * n + 2) return false;
+
+    std::memcpy(&record, &slot.record, sizeof(Record));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return slot.seq.load(std::memory_order_relaxed) == 2 * n + 2;
+  };
+
+  /**
+  *   @brief unmap segment (and remove it if owned by producer)
+  *
+  **/
+  inline void unmap(const Header *ring, const std::string name, const bool remove)
+  {
+    munmap((void *) ring, getBytes(ring->capacity));
+    if(remove) shm_unlink(getSegmentName(name).c_str());
+  };
+
+} // namespace Telemetry
+
+#endif // __GKC_TELEMETRY_H__
@@ -0,0 +1,133 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: TelemetryReader.cpp
+ *
+ *    Description: Reads live telemetry of a running simulation (gkc-telemetry)
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cerrno>
+#include <csignal>
+#include <algorithm>
+
+#include "Tools/Telemetry.h"
+
+/**
+*   @brief print column names
+*
+**/
+static void printHeader(const Telemetry::Header *ring, const Telemetry::Record &record)
+{
+  std::cout << "# gkc telemetry (pid " << ring->pid << ")" << std::endl
+            << "# Timestep Time dt WallTime StepTime phiEnergy ApEnergy BpEnergy";
+
+  for(int s = 0; s < ring->numSpecies; s++) {
+    const std::string n = ring->species[s];
+    std::cout << " N(" << n << ") K(" << n << ") Q(" << n << ") G(" << n << ")";
+  }
+
+  // stage names may contain spaces
+  for(int n = 0; n < record.numStages; n++) {
+    std::string stage = record.stage[n].name;
+    std::replace(stage.begin(), stage.end(), ' ', '_');
+    std::cout << " " << stage;
+  }
+
+  std::cout << std::endl;
+}
+
+/**
+*   @brief print record as single line (heat and particle flux of φ only)
+*
+**/
+static void printRecord(const Telemetry::Header *ring, const Telemetry::Record &r)
+{
+  std::cout << std::setw(8) << r.timestep << std::scientific << std::setprecision(6)
+            << " " << r.time << " " << r.dt << " " << r.walltime << " " << r.stepTime
+            << " " << r.phiEnergy << " " << r.ApEnergy << " " << r.BpEnergy;
+
+  for(int s = 0; s < ring->numSpecies; s++) {
+    std::cout << " " << r.particle_number[s] << " " << r.kinetic_energy[s]
+              << " " << r.heat_flux[ring->numFields * s] << " " << r.particle_flux[ring->numFields * s];
+  }
+
+  for(int n = 0; n < r.numStages; n++) std::cout << " " << r.stage[n].cost;
+
+  std::cout << std::endl;
+}
+
+/**
+*   @brief Program starting point of gkc-telemetry
+*
+*   Prints the records of the telemetry ring buffer (see Telemetry), one
+*   line per record in columns (e.g. for gnuplot). With -f new records are
+*   printed as they are published, until the simulation stops.
+*
+*   Usage : gkc-telemetry [-f] <name>
+*
+**/
+int main(int argc, char **argv)
+{
+  const bool follow = (argc == 3) && (std::string(argv[1]) == "-f");
+
+  if((argc != 2) && !follow) {
+    std::cerr << "Usage : " << argv[0] << " [-f] <name>" << std::endl;
+    return 1;
+  }
+
+  const std::string name(argv[argc-1]);
+
+  const Telemetry::Header *ring = Telemetry::map(name);
+
+  if(ring == nullptr) {
+    std::cerr << "Cannot open telemetry segment " << Telemetry::getSegmentName(name) << std::endl;
+    return 1;
+  }
+
+  // start with oldest available record
+  const uint64_t head = Telemetry::getHead(ring);
+  uint64_t       next = (head > ring->capacity) ? head - ring->capacity : 0;
+
+  bool printedHeader = false;
+
+  for(;;) {
+
+    for(; next < Telemetry::getHead(ring); next++) {
+
+      Telemetry::Record record;
+
+      if(!Telemetry::read(ring, next, record)) {
+
+        // overwritten by producer, continue with oldest available record
+        const uint64_t last   = Telemetry::getHead(ring),
+                       oldest = (last > ring->capacity) ? last - ring->capacity : 0;
+        if(oldest > next) std::cout << "# skipped " << (oldest - next) << " records" << std::endl;
+        next = std::max(oldest, next) - 1;
+        continue;
+      }
+
+      if(!printedHeader) { printHeader(ring, record); printedHeader = true; }
+
+      printRecord(ring, record);
+    }
+
+    std::cout << std::flush;
+
+    // stop if producer exited
+    if(!follow || ((kill(ring->pid, 0) != 0) && (errno == ESRCH))) break;
+
+    usleep(200000);
+  }
+
+  Telemetry::unmap(ring, name, false);
+
+  return 0;
+}
@@ -39,6 +39,7 @@ class Visualization {
   protected:
 
    Timing dataOutputVisual;
+   Scheduler::Task *taskVisual; ///< Scheduled output (set by derived class)
 
    Vlasov *vlasov;
    Fields *fields;
@@ -46,7 +47,7 @@ class Visualization {
   public:
 
    Visualization(Vlasov *_vlasov, Fields *_fields, Grid *_grid, Setup *setup, Parallel *_parallel) 
-                : vlasov(_vlasov), fields(_fields), parallel(_parallel) {
+                : taskVisual(nullptr), vlasov(_vlasov), fields(_fields), parallel(_parallel) {
 
     dataOutputVisual      = Timing( setup->get("DataOutput.Visualization.Step", -1),
                                     setup->get("DataOutput.Visualization.Time", -1.));
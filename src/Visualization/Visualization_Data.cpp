@@ -41,9 +41,9 @@ Visualization_Data::Visualization_Data(Grid *grid, Parallel *_parallel, Setup *s
      
     bool write = (parallel->Coord[DIR_VMS] == 0) && (parallel->Coord[DIR_Z] == 0);
     
-    FA_slphi  = new FileAttr("Phi", visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 1, fileIO->complex_tid);
-    FA_slAp   = new FileAttr("Ap" , visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 2, fileIO->complex_tid);
-    FA_slBp   = new FileAttr("Bp" , visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 3, fileIO->complex_tid);
+    FA_slphi  = new FileAttr("Phi", visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 1, fileIO->complex_tid, true, true);
+    FA_slAp   = new FileAttr("Ap" , visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 2, fileIO->complex_tid, true, true);
+    FA_slBp   = new FileAttr("Bp" , visGroup, fileIO->file, 4, dim, mdim, cdim, moff, cBdim, off, write && Nq >= 3, fileIO->complex_tid, true, true);
     FA_slTime = fileIO->newTiming(visGroup);
 
   }
@@ -59,12 +59,14 @@ Visualization_Data::Visualization_Data(Grid *grid, Parallel *_parallel, Setup *s
     hsize_t cdim [] = { NxLD, NvLD, NsLD,             1 };
     hsize_t moff [] = { 0   , 0   , 0   ,             0 };
      
-    FA_XV  = new FileAttr("XV",  visGroup, fileIO->file, 4, dim, mdim, cdim, moff,  cBdim, offset0, true, fileIO->complex_tid);
+    FA_XV  = new FileAttr("XV",  visGroup, fileIO->file, 4, dim, mdim, cdim, moff,  cBdim, offset0, true, fileIO->complex_tid, true, true);
   
   } 
      
   H5Gclose(visGroup);
 
+  taskVisual = fileIO->scheduler->add("Visualization", dataOutputVisual);
+
 }   
     
 Visualization_Data::~Visualization_Data() 
@@ -82,7 +84,9 @@ Visualization_Data::~Visualization_Data()
 void Visualization_Data::writeData(const Timing &timing, const double dt, const bool force) 
 {
     
-  if (timing.check(dataOutputVisual,dt) || force) {
+  if (taskVisual->check(timing, dt) || force) {
+
+    Scheduler::Scope cost(taskVisual);
 
     [=](CComplex Field0[Nq][NzLD][Nky][NxLD]) {
     
@@ -12,6 +12,9 @@
  */
 
 #include "Vlasov.h"
+#include "Tools/RawSnapshot.h"
+#include "Special/Interpolate/LagrangeInterpolation.h"
+#include "Special/Interpolate/SpectralInterpolation.h"
 
 
 Vlasov::Vlasov(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *fileIO, Geometry *_geo, FFTSolver *_fft, Benchmark *_bench, Collisions *_coll)
@@ -26,12 +29,22 @@ Vlasov::Vlasov(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *fileIO,
 , _kw_16_dx4  ( 1./(16.*pow4(dx)))
 
 {
-  ArrayPhase = nct::allocate(grid->RsLD, grid->RmLB, grid->RzLB, grid->RkyLD, grid->RxLB, grid->RvLB);
-  ArrayPhase(&f0, &f, &fss, &fs, &f1, &ft, &Coll);
+  // Phase space arrays are zeroed in parallel to place pages on the NUMA node of 
+  // the accessing thread (first-touch) and use transparent huge pages
+  useNUMA = setup->get("Vlasov.FirstTouch", 1);
+  const nct::alloc_flags phase_flags = useNUMA ? nct::alloc_flags::USE_NUMA : nct::alloc_flags::USE_DEFAULT;
+  
+  ArrayPhase = nct::allocate(grid->RsLD, grid->RmLB, grid->RzLB, grid->RkyLD, grid->RxLB, grid->RvLB, phase_flags).purpose("Phase space");
+  ArrayPhase(&f, &fss, &fs, &ft);
+  
+  // collision operator adds directly into the Runge-Kutta stage (see solve)
+  doCollisions = coll->isCollisional();
+  
+  ArrayF0 = nct::allocate(grid->RsLD, grid->RmLB, grid->RzLB, grid->RxLB, grid->RvLB, phase_flags).purpose("Maxwellian")(&f0);
    
-  ArrayXi = nct::allocate(grid->RzLB , grid->RkyLD, grid->RxLB4, grid->RvLB)(&Xi);
-  ArrayG  = nct::allocate(grid->RzLB , grid->RkyLD, grid->RxLB , grid->RvLB)(&G );
-  ArrayNL = nct::allocate(grid->RkyLD, grid->RxLD , grid->RvLD)(&nonLinearTerm);
+  ArrayXi = nct::allocate(grid->RzLB , grid->RkyLD, grid->RxLB4, grid->RvLB).purpose("Gyro-averaged fields")(&Xi);
+  ArrayG  = nct::allocate(grid->RzLB , grid->RkyLD, grid->RxLB , grid->RvLB).purpose("Gyro-averaged fields")(&G );
+  ArrayNL = nct::allocate(grid->RkyLD, grid->RxLD , grid->RvLD).purpose("Non-linear term")(&nonLinearTerm);
    
   // allocate boundary (MPI) buffers
   int BoundX_num =    2 * Nky * NzLD * NvLD * NmLD * NsLD;
@@ -40,10 +53,10 @@ Vlasov::Vlasov(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *fileIO,
   // do not allocate for M if not used
   int BoundM_num = (NmLlD == NmLlB) ? 0 : NxLD * Nky * NzLD * NvLD *    2 * NsLD;
 
-  ArrayBoundX = nct::allocate(nct::Range(0 , BoundX_num ))(&SendXu, &SendXl, &RecvXl, &RecvXu);
-  ArrayBoundZ = nct::allocate(nct::Range(0 , BoundZ_num ))(&SendZu, &SendZl, &RecvZl, &RecvZu);
-  ArrayBoundV = nct::allocate(nct::Range(0 , BoundV_num ))(&SendVu, &SendVl, &RecvVl, &RecvVu);
-  ArrayBoundM = nct::allocate(nct::Range(0 , BoundM_num ))(&SendMu, &SendMl, &RecvMl, &RecvMu);
+  ArrayBoundX = nct::allocate(nct::Range(0 , BoundX_num )).purpose("Boundary buffers")(&SendXu, &SendXl, &RecvXl, &RecvXu);
+  ArrayBoundZ = nct::allocate(nct::Range(0 , BoundZ_num )).purpose("Boundary buffers")(&SendZu, &SendZl, &RecvZl, &RecvZu);
+  ArrayBoundV = nct::allocate(nct::Range(0 , BoundV_num )).purpose("Boundary buffers")(&SendVu, &SendVl, &RecvVl, &RecvVu);
+  ArrayBoundM = nct::allocate(nct::Range(0 , BoundM_num )).purpose("Boundary buffers")(&SendMu, &SendMl, &RecvMl, &RecvMu);
   
   equation_type       = setup->get("Vlasov.Equation"   , "ES");        
   doNonLinear         = setup->get("Vlasov.doNonLinear", 0      );
@@ -56,6 +69,13 @@ Vlasov::Vlasov(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *fileIO,
   dataOutputF1      = Timing( setup->get("DataOutput.Vlasov.Step", -1),
                               setup->get("DataOutput.Vlasov.Time", -1.));
 
+  dataOutputCheckpoint = Timing( setup->get("DataOutput.Checkpoint.Step", -1),
+                                 setup->get("DataOutput.Checkpoint.Time", -1.));
+
+  dataOutputRaw     = Timing( setup->get("DataOutput.RawSnapshot.Step", -1),
+                              setup->get("DataOutput.RawSnapshot.Time", -1.));
+  rawPrefix         = setup->get("DataOutput.RawSnapshot.Prefix", "snapshot");
+
   // Parse operators
   ArrayKrook = nct::allocate(grid->RxGD)(&krook);  
   FunctionParser krook_parser = setup->getFParser();
@@ -73,10 +93,10 @@ Vlasov::~Vlasov()
   closeData();
 }
 
-void Vlasov::solve(Fields *fields, CComplex  *_fs, CComplex  *_fss, 
+void Vlasov::solve(Fields *fields, PComplex  *_fs, PComplex  *_fss, 
                    double dt, int rk_step, const double rk[3], bool useNonBlockingBoundary)
 {
-  static CComplex *f_boundary = nullptr;
+  static PComplex *f_boundary = nullptr;
 
   useNonBlockingBoundary =  false;
 
@@ -88,14 +108,19 @@ void Vlasov::solve(Fields *fields, CComplex  *_fs, CComplex  *_fss,
 
   Xi_max[:] = 0.; // Needed to calculate CFL time step 
   
-  // Calculate the collision operator
-  // BUG : how to deal with velocity space decomposition ?!
-  coll->solve(fields, _fs, f0, Coll, dt, rk_step);
-       
   // Calculate the Vlasov equation
   #pragma omp barrier
   solve(equation_type, fields, _fs, _fss, dt, rk_step, rk);
 
+  // Add the collision operator to the stage update of ft and fss, 
+  // thread decomposition differs from the Vlasov kernels, thus synchronize
+  // BUG : how to deal with velocity space decomposition ?!
+  if(doCollisions) {
+    #pragma omp barrier
+    coll->solve(fields, _fs, f0, ft, _fss, rk, dt, rk_step);
+    #pragma omp barrier
+  }
+
 
   // Note : we have non-blocking boundaries as Poisson solver does not require ghosts
   // Set nowait, as field solver does not require boundaries & analysis too ... ?! 
@@ -107,24 +132,24 @@ void Vlasov::solve(Fields *fields, CComplex  *_fs, CComplex  *_fss,
   f_boundary = _fss; 
 }
 
-void Vlasov::setBoundary(CComplex *f) 
+void Vlasov::setBoundary(PComplex *f) 
 { 
   setBoundary(f, Boundary::SENDRECV); 
 }
 
 
-void Vlasov::setBoundary(CComplex *f, Boundary boundary_type)
+void Vlasov::setBoundary(PComplex *f, Boundary boundary_type)
 {
   [=] (
-         CComplex g     [NsLD][NmLD][NzLB][Nky][NxLB][NvLB],
-         CComplex SendXl[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], CComplex SendXu[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], 
-         CComplex RecvXl[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], CComplex RecvXu[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], 
-         CComplex SendZl[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD], CComplex SendZu[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD],
-         CComplex RecvZl[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD], CComplex RecvZu[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD],
-         CComplex SendVl[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ], CComplex SendVu[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ],
-         CComplex RecvVl[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ], CComplex RecvVu[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ],
-         CComplex SendMl[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD], CComplex SendMu[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD],
-         CComplex RecvMl[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD], CComplex RecvMu[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD])
+         PComplex g     [NsLD][NmLB][NzLB][Nky][NxLB][NvLB],
+         PComplex SendXl[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], PComplex SendXu[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], 
+         PComplex RecvXl[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], PComplex RecvXu[NsLD][NmLD][NzLD][Nky][GC2 ][NvLD], 
+         PComplex SendZl[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD], PComplex SendZu[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD],
+         PComplex RecvZl[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD], PComplex RecvZu[NsLD][NmLD][GC2 ][Nky][NxLD][NvLD],
+         PComplex SendVl[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ], PComplex SendVu[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ],
+         PComplex RecvVl[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ], PComplex RecvVu[NsLD][NmLD][NzLD][Nky][NxLD][GC2 ],
+         PComplex SendMl[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD], PComplex SendMu[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD],
+         PComplex RecvMl[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD], PComplex RecvMu[NsLD][GC2 ][NzLD][Nky][NxLD][NvLD])
   {
 
   /////////////////////////// Send Boundaries //////////////////////////////
@@ -166,8 +191,6 @@ void Vlasov::setBoundary(CComplex *f, Boundary boundary_type)
     
     if(parallel->decomposition[DIR_M] > 1 && (NmLlD != NmLlB)) { // take care with lower/upper global boundary
      
-      check(-1, DMESG("Should not come here"));
-
       SendMl[:][:][:][:][:][:] = g[NsLlD:NsLD][NmLlD  :2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD]; 
       SendMu[:][:][:][:][:][:] = g[NsLlD:NsLD][NmLuD-1:2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD]; 
       parallel->updateBoundaryVlasov(Vlasov::SendMu, Vlasov::SendMl, Vlasov::RecvMu, Vlasov::RecvMl, ArrayBoundM.getNum(), DIR_M);
@@ -207,15 +230,29 @@ void Vlasov::setBoundary(CComplex *f, Boundary boundary_type)
       g[NsLlD:NsLD][NmLlB  :2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD] = RecvMl[:][:][:][:][:][:]; 
       g[NsLlD:NsLD][NmLuD+1:2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD] = RecvMu[:][:][:][:][:][:]; 
     }
+
+    // M is not periodic, set ghost cells at global boundary to zero (MPI_PROC_NULL neighbour)
+    if(NmLlD != NmLlB) {
+
+      if(NmLlD == NmGlD) g[NsLlD:NsLD][NmLlB  :2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD] = 0.;
+      if(NmLuD == NmGuD) g[NsLlD:NsLD][NmLuD+1:2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlD:NvLD] = 0.;
+
+      // corners (m,v) are not exchanged, they are zero as long as either v or m 
+      // is not decomposed (required by mixed derivatives, see PitchAngle)
+      g[NsLlD:NsLD][NmLlB  :2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlB  :2] = 0.;
+      g[NsLlD:NsLD][NmLlB  :2][NzLlD:NzLD][:][NxLlD:NxLD][NvLuD+1:2] = 0.;
+      g[NsLlD:NsLD][NmLuD+1:2][NzLlD:NzLD][:][NxLlD:NxLD][NvLlB  :2] = 0.;
+      g[NsLlD:NsLD][NmLuD+1:2][NzLlD:NzLD][:][NxLlD:NxLD][NvLuD+1:2] = 0.;
+    }
   
   
   }
   
-  }  ((A6zz) f, 
-      (A6zz) SendXl,  (A6zz) SendXu,  (A6zz) RecvXl,  (A6zz) RecvXu,
-      (A6zz) SendZl,  (A6zz) SendZu,  (A6zz) RecvZl,  (A6zz) RecvZu,
-      (A6zz) SendVl,  (A6zz) SendVu,  (A6zz) RecvVl,  (A6zz) RecvVu,
-      (A6zz) SendMl,  (A6zz) SendMu,  (A6zz) RecvMl,  (A6zz) RecvMu);
+  }  ((A6pp) f, 
+      (A6pp) SendXl,  (A6pp) SendXu,  (A6pp) RecvXl,  (A6pp) RecvXu,
+      (A6pp) SendZl,  (A6pp) SendZu,  (A6pp) RecvZl,  (A6pp) RecvZu,
+      (A6pp) SendVl,  (A6pp) SendVu,  (A6pp) RecvVl,  (A6pp) RecvVu,
+      (A6pp) SendMl,  (A6pp) SendMu,  (A6pp) RecvMl,  (A6pp) RecvMu);
 }
 
 double Vlasov::getMaxNLTimeStep(const double maxCFL) 
@@ -246,39 +283,129 @@ void Vlasov::initData(Setup *setup, FileIO *fileIO)
   check(H5LTset_attribute_double(psfGroup, ".", "HyperViscosity", hyp_visc, 6), DMESG("Attribute"));
   check(H5LTset_attribute_double(psfGroup, ".", "Krook"         , &krook[NxGlD], Nx), DMESG("Attribute"));
   
-  // Phase space dimensions
+  // Phase space dimensions (file offset in mu starts at local domain, as ghost cells in mu are optional)
+  const hsize_t NmGC  = NmLlD - NmLlB;
+
   hsize_t dim[]       = { Ns     ,      Nm, Nz     , Nky   , Nx     , Nv     ,             1 };
   hsize_t maxdim[]    = { Ns     ,      Nm, Nz     , Nky   , Nx     , Nv     , H5S_UNLIMITED };
   hsize_t chunkBdim[] = { NsLB   ,    NmLB, NzLB   , Nky   , NxLB   , NvLB   , 1             };
   hsize_t chunkdim[]  = { NsLD   ,    NmLD, NzLD   , Nky   , NxLD   , NvLD   , 1             };
-  hsize_t offset[]    = { NsLlB-1, NmLlB-1, NzLlB-1, NkyLlB, NxLlB-1, NvLlB-1, 0             };
-  hsize_t moffset[]   = { 0      , 0      , 2      , 0     , 2      , 2      , 0             };
+  hsize_t offset[]    = { NsLlB-1, NmLlD-1, NzLlB-1, NkyLlB, NxLlB-1, NvLlB-1, 0             };
+  hsize_t moffset[]   = { 0      , NmGC   , 2      , 0     , 2      , 2      , 0             };
+  
+  // Maxwellian dimensions (real and independent of k_y)
+  hsize_t f0_dim[]       = { Ns     ,      Nm, Nz     , Nx     , Nv     ,             1 };
+  hsize_t f0_maxdim[]    = { Ns     ,      Nm, Nz     , Nx     , Nv     , H5S_UNLIMITED };
+  hsize_t f0_chunkBdim[] = { NsLB   ,    NmLB, NzLB   , NxLB   , NvLB   , 1             };
+  hsize_t f0_chunkdim[]  = { NsLD   ,    NmLD, NzLD   , NxLD   , NvLD   , 1             };
+  hsize_t f0_offset[]    = { NsLlB-1, NmLlD-1, NzLlB-1, NxLlB-1, NvLlB-1, 0             };
+  hsize_t f0_moffset[]   = { 0      , NmGC   , 2      , 2      , 2      , 0             };
      
   // ignore, as HDF-5 automatically (?) allocated data for it
-  FA_f0       = new FileAttr("f0", psfGroup, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->complex_tid);
-  FA_f1       = new FileAttr("f1", psfGroup, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->complex_tid);
+  FA_f0       = new FileAttr("f0", psfGroup, fileIO->file, 6, f0_dim, f0_maxdim, f0_chunkdim, f0_moffset,  f0_chunkBdim, f0_offset, true);
+  FA_f1       = new FileAttr("f1", psfGroup, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->phase_tid, true, true);
   FA_psfTime  = fileIO->newTiming(psfGroup);
+
+  taskF1      = fileIO->scheduler->add("Vlasov.F1", dataOutputF1);
   // call additional routines
 
   H5Gclose(psfGroup);
 
-  if(fileIO->resumeFile == true) {
+  // raw snapshot is used if decomposition matches, otherwise fall back to HDF-5 input
+  const std::string rawInput = setup->get("DataOutput.RawSnapshot.Input", "");
+
+  bool readRaw = (rawInput != "") && readRawSnapshot(rawInput);
+
+  if((rawInput != "") && !readRaw) {
+
+    check(fileIO->inputFileName != "" ? 1 : -1, DMESG("Raw snapshot does not match decomposition/grid, and no HDF-5 input file is given"));
+    parallel->print("Vlasov : raw snapshot does not match, resuming from HDF-5 input");
+    readRaw = false;
+  }
+
+  bool interpolated = false;
+
+  if((fileIO->resumeFile == true) && !readRaw) {
 
     // Currently we handle it here (should find better place)
     hid_t file_in = check(H5Fopen (fileIO->inputFileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), DMESG("H5Fopen"));
 
-    // have to read from new file 
-    FileAttr *FA_in_f0 = new FileAttr("/Vlasov/f0", file_in, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->complex_tid, false);
-    FileAttr *FA_in_f1 = new FileAttr("/Vlasov/f1", file_in, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->complex_tid, false);
+    // restart files point to the last complete slot, otherwise use last time step 
+    int slot = -1;
+    if(H5Aexists_by_name(file_in, "/Vlasov", "Slot", H5P_DEFAULT) > 0) {
+
+      check(H5LTget_attribute_int(file_in, "/Vlasov", "Slot", &slot), DMESG("H5LTget_attribute"));
+
+      // slots of a new checkpoint file are uninitialized until the first checkpoint is complete
+      if(slot < 0) check(-1, DMESG("Checkpoint file " + fileIO->inputFileName + " does not contain a complete checkpoint (Slot < 0)"));
+    }
+
+    // resolution of input file (decomposition may differ, as each process reads its domain)
+    hsize_t in_dim[7];
+    hid_t dset_in = check(H5Dopen(file_in, "/Vlasov/f1", H5P_DEFAULT), DMESG("H5Dopen"));
+    hid_t dspace_in = H5Dget_space(dset_in);
+    H5Sget_simple_extent_dims(dspace_in, in_dim, NULL);
+    H5Sclose(dspace_in); 
+    H5Dclose(dset_in);
+
+    interpolated = (std::equal(dim, dim+6, in_dim) == false);
 
-    FA_in_f0->read(ArrayPhase.data(f0));
-    FA_in_f1->read(ArrayPhase.data(f ));
+    if(interpolated) {
+
+      parallel->print("Vlasov : resolution of input file differs, interpolating phase-space function");
+      readInterpolated(file_in, fileIO, slot);
+    } 
+    else {
+
+      // have to read from new file 
+      FileAttr *FA_in_f0 = new FileAttr("/Vlasov/f0", file_in, fileIO->file, 6, f0_dim, f0_maxdim, f0_chunkdim, f0_moffset,  f0_chunkBdim, f0_offset, true, H5T_NATIVE_DOUBLE, false);
+      FileAttr *FA_in_f1 = new FileAttr("/Vlasov/f1", file_in, fileIO->file, 7, dim, maxdim, chunkdim, moffset,  chunkBdim, offset, true, fileIO->phase_tid, false);
+
+      FA_in_f0->read(ArrayF0.data(f0));
+    
+      if(slot >= 0) FA_in_f1->readAt(ArrayPhase.data(f ), slot);
+      else          FA_in_f1->read  (ArrayPhase.data(f ));
          
-    delete FA_in_f0;
-    delete FA_in_f1;
+      delete FA_in_f0;
+      delete FA_in_f1;
+    }
 
     H5Fclose(file_in); 
   }
+
+  ////////////////////////// Checkpoint (restart) file with rotating slots ///////////////////
+  
+  checkpointSlots = setup->get("DataOutput.Checkpoint.Slots", 0);
+  checkpointSlot  = -1;
+  checkpointF0    = false;
+  
+  if(checkpointSlots > 0) {
+
+    const std::string name = setup->get("DataOutput.Checkpoint.FileName", "restart.h5");
+
+    // if resumed from restart file, we continue to use it (and its slots), unless resolution changed
+    const bool reuse = fileIO->resumeFile && (name == fileIO->inputFileName) && !interpolated;
+
+    checkpointFile = fileIO->openFile(setup, name, !reuse);
+
+    hid_t chkGroup = reuse ? check(H5Gopen(checkpointFile, "/Vlasov", H5P_DEFAULT), DMESG("H5Gopen")) 
+                           : fileIO->newGroup("/Vlasov", checkpointFile);
+
+    if(reuse) check(H5LTget_attribute_int(checkpointFile, "/Vlasov", "Slot", &checkpointSlot), DMESG("H5LTget_attribute"));
+    else      check(H5LTset_attribute_int(chkGroup, ".", "Slot", &checkpointSlot, 1), DMESG("H5LTset_attribute"));
+
+    // grid is required to restart with a different resolution (see readInterpolated)
+    if(!reuse) grid->initData(fileIO, checkpointFile);
+
+    // fixed number of slots 
+    hsize_t chk_dim[]    = { Ns, Nm, Nz, Nky, Nx, Nv, hsize_t(checkpointSlots) }; 
+    hsize_t chk_f0_dim[] = { Ns, Nm, Nz,      Nx, Nv, 1                        };
+     
+    FA_chk_f0 = new FileAttr("f0", chkGroup, checkpointFile, 6, chk_f0_dim, chk_f0_dim, f0_chunkdim, f0_moffset, f0_chunkBdim, f0_offset, true, H5T_NATIVE_DOUBLE, !reuse);
+    FA_chk_f1 = new FileAttr("f1", chkGroup, checkpointFile, 7, chk_dim   , chk_dim   , chunkdim   , moffset   , chunkBdim   , offset   , true, fileIO->phase_tid, !reuse);
+    
+    H5Gclose(chkGroup);
+  }
 }
 
 void Vlasov::closeData() 
@@ -286,19 +413,332 @@ void Vlasov::closeData()
   delete FA_f0;
   delete FA_f1;
   delete FA_psfTime;
+
+  if(checkpointSlots > 0) {
+
+    delete FA_chk_f0;
+    delete FA_chk_f1;
+
+    AsyncIO::wait();
+    H5Fclose(checkpointFile);
+  }
 }
 
 
 void Vlasov::writeData(const Timing &timing, const double dt) 
 {
-  if (timing.check(dataOutputF1, dt)       )   {
+  if (taskF1->check(timing, dt)       )   {
       
-    FA_f0->write(ArrayPhase.data(f0));
+    Scheduler::Scope cost(taskF1);
+
+    FA_f0->write(ArrayF0.data(f0));
     FA_f1->write(ArrayPhase.data(f ));
     FA_psfTime->write(&timing);
       
     parallel->print("Wrote phase-space data ... "); 
   }
+
+  if((checkpointSlots > 0) && timing.check(dataOutputCheckpoint, dt)) writeCheckpoint(timing);
+  
+  if(timing.check(dataOutputRaw, dt)) writeRawSnapshot(timing);
+}
+
+/**
+*   @brief layout of f0 and f1 in raw snapshot, same as HDF-5 output (see initData)
+*
+**/
+static RawSnapshot::Header getRawHeader(Parallel *parallel)
+{
+  RawSnapshot::Header header;
+  std::memset(&header, 0, sizeof(header));
+
+  header.rank         = parallel->myRank;
+  header.numProcesses = parallel->numProcesses;
+  for(int dir = DIR_X; dir <= DIR_S; dir++) header.decomposition[dir] = parallel->decomposition[dir];
+
+  // equidistant grids (see Grid), required by gkc-raw2h5 to write /Grid
+  RawSnapshot::GridInfo g = { Lx, Ly, Lz, X[NxGlD], dx, Z[NzGlD], dz, V[NvGlD], dv };
+  header.grid = g;
+
+  header.numArrays = 2;
+
+  const uint64_t NmGC = NmLlD - NmLlB; // ghost cells in mu (optional)
+  
+  RawSnapshot::Layout f0 = { "f0", 6, sizeof(double), 0, 0,
+                             { Ns     ,      Nm, Nz     , Nx     , Nv     , 1 },
+                             { NsLB   ,    NmLB, NzLB   , NxLB   , NvLB   , 1 },
+                             { NsLD   ,    NmLD, NzLD   , NxLD   , NvLD   , 1 },
+                             { 0      , NmGC   , 2      , 2      , 2      , 0 },
+                             { NsLlB-1, NmLlD-1, NzLlB-1, NxLlB-1, NvLlB-1, 0 }, 0, 0 };
+
+  RawSnapshot::Layout f1 = { "f1", 7, sizeof(PComplex), 1, 0,
+                             { Ns     ,      Nm, Nz     , Nky   , Nx     , Nv     , 1 },
+                             { NsLB   ,    NmLB, NzLB   , Nky   , NxLB   , NvLB   , 1 },
+                             { NsLD   ,    NmLD, NzLD   , Nky   , NxLD   , NvLD   , 1 },
+                             { 0      , NmGC   , 2      , 0     , 2      , 2      , 0 },
+                             { NsLlB-1, NmLlD-1, NzLlB-1, NkyLlB, NxLlB-1, NvLlB-1, 0 }, 0, 0 };
+
+  header.array[0] = f0;
+  header.array[1] = f1;
+
+  RawSnapshot::setOffsets(header);
+
+  return header;
+}
+
+void Vlasov::writeRawSnapshot(const Timing &timing)
+{
+  RawSnapshot::Header header = getRawHeader(parallel);
+
+  header.timestep = timing.step;
+  header.time     = timing.time;
+
+  const void *data[] = { ArrayF0.data(f0), ArrayPhase.data(f) };
+
+  const std::string name = RawSnapshot::getFileName(rawPrefix, parallel->myRank);
+
+  // failure on single process should not abort simulation (no collectives involved)
+  if(!RawSnapshot::write(name, header, data)) std::cerr << "Vlasov : failed to write raw snapshot " << name << std::endl;
+  else parallel->print("Wrote raw snapshot ... ");
+}
+
+bool Vlasov::readRawSnapshot(const std::string prefix)
+{
+  const RawSnapshot::Header local = getRawHeader(parallel);
+  
+  RawSnapshot::Header header;
+  size_t size;
+  
+  const char *map = RawSnapshot::map(RawSnapshot::getFileName(prefix, parallel->myRank), header, size);
+
+  // layout (including decomposition and grid) has to be identical
+  bool match = (map != nullptr) && (header.rank == local.rank) && (header.numProcesses == local.numProcesses)
+            && (header.numArrays == local.numArrays)
+            && (std::memcmp(header.decomposition, local.decomposition, sizeof(local.decomposition)) == 0)
+            && (std::memcmp(header.array, local.array, sizeof(local.array)) == 0)
+            && (std::memcmp(&header.grid, &local.grid, sizeof(local.grid)) == 0)
+            && (size >= header.array[1].offset + header.array[1].bytes);
+
+  match = parallel->reduce(match ? 0 : 1, Op::sum) == 0;
+
+  // each process renames its own file, thus an interrupted dump may leave 
+  // snapshots of different time steps (as rejected by gkc-raw2h5)
+  if(match) {
+
+    match = (parallel->reduce((int) header.timestep, Op::min) == parallel->reduce((int) header.timestep, Op::max))
+         && (parallel->reduce(header.time          , Op::min) == parallel->reduce(header.time          , Op::max));
+  }
+
+  if(match) {
+
+    std::memcpy(ArrayF0.data(f0)  , map + header.array[0].offset, header.array[0].bytes);
+    std::memcpy(ArrayPhase.data(f), map + header.array[1].offset, header.array[1].bytes);
+  }
+
+  if(map != nullptr) RawSnapshot::unmap(map, size);
+
+  return match;
+}
+
+/**
+*   @brief read block of input dataset and interpolate to local domain
+*
+*   Reads [z][k_y][x][v] of species s and μ-point m at time index t (without
+*   k_y dimension for f0), which covers the stencils of the local domain (z-planes
+*   are read separately, as stencils wrap around periodically), and interpolates
+*   in x (spectral) and z, v (Lagrange) to out[z][k_y][x][v].
+*
+**/
+template<class T> static void interpolateBlock(hid_t dataset, hid_t type, const int ndim, const hsize_t t, 
+                                               const int s, const int m, const int Nk, const int Nx_in, const int Nz_in,
+                                               const SpectralInterpolation &intX, const LagrangeInterpolation &intZ,
+                                               const LagrangeInterpolation &intV, T *out)
+{
+  // z is periodic, thus stencils may wrap around (indices modulo Nz_in)
+  int z0 = intZ.getFirst(0), z1 = z0;
+  for(int z = 0; z < NzLD; z++) { z0 = std::min(z0, intZ.getFirst(z)); z1 = std::max(z1, intZ.getFirst(z)); }
+
+  const int order_z = intZ.getOrder(), nz = z1 + order_z - z0;
+  const int order_v = intV.getOrder(), v0 = intV.getFirst(0), nv = intV.getFirst(NvLD-1) + order_v - v0;
+
+  // hyperslab [s][m][z][k_y][x][v][t] of input dataset
+  hsize_t off[7], count[7];
+  int d = 0;
+
+  off[d] = s - NsGlD; count[d++] = 1    ;
+  off[d] = m - NmGlD; count[d++] = 1    ;
+  off[d] = 0        ; count[d++] = 1    ;
+  if(ndim == 7) { off[d] = 0; count[d++] = Nk; }
+  off[d] = 0        ; count[d++] = Nx_in;
+  off[d] = v0       ; count[d++] = nv   ;
+  off[d] = t        ; count[d++] = 1    ;
+
+  std::vector<T> in(nz * Nk * Nx_in * nv), tmp(nz * Nk * NxLD * nv, T(0));
+
+  hid_t dspace = H5Dget_space(dataset);
+  hid_t mspace = H5Screate_simple(ndim, count, NULL);
+
+  // read each z-plane separately, as the stencil may wrap around
+  for(int z = 0; z < nz; z++) {
+
+    off[2] = ((z0 + z) % Nz_in + Nz_in) % Nz_in;
+    check(H5Sselect_hyperslab(dspace, H5S_SELECT_SET, off, NULL, count, NULL), DMESG("HDF-5 Error"));
+    check(H5Dread(dataset, type, mspace, dspace, H5P_DEFAULT, &in[z * Nk * Nx_in * nv]), DMESG("HDF-5 Error"));
+  }
+
+  H5Sclose(mspace);
+  H5Sclose(dspace);
+
+  // x : spectral interpolation (matrix product with weights of local points)
+  for(int zk = 0; zk < nz * Nk; zk++) { for(int x = 0; x < NxLD; x++) {
+
+    const double *w = intX.getWeights(x);
+
+    T *_tmp = &tmp[(zk * NxLD + x) * nv];
+
+    for(int j = 0; j < Nx_in; j++) { 
+
+      const T *_in = &in[(zk * Nx_in + j) * nv];
+      for(int v = 0; v < nv; v++) _tmp[v] += w[j] * _in[v];
+    }
+  } }
+
+  // z, v : Lagrange interpolation
+  for(int z = 0; z < NzLD; z++) { for(int k = 0; k < Nk; k++) { for(int x = 0; x < NxLD; x++) {
+
+    const double *w_z = intZ.getWeights(z);
+    const int     z_  = intZ.getFirst(z) - z0;
+
+    for(int v = 0; v < NvLD; v++) {
+
+      const double *w_v = intV.getWeights(v);
+      const int     v_  = intV.getFirst(v) - v0;
+
+      T val = T(0);
+
+      for(int a = 0; a < order_z; a++) { for(int b = 0; b < order_v; b++) {
+
+        val += w_z[a] * w_v[b] * tmp[(((z_+a) * Nk + k) * NxLD + x) * nv + v_+b];
+      } }
+
+      out[((z * Nk + k) * NxLD + x) * NvLD + v] = val;
+    }
+  } } }
+}
+
+void Vlasov::readInterpolated(hid_t file_in, FileIO *fileIO, const int slot)
+{
+  // grid of input file
+  int    Nx_in, Nky_in, Nz_in, Nv_in, Nm_in, Ns_in;
+  double Lx_in, Ly_in, Lz_in;
+
+  if(H5Lexists(file_in, "/Grid", H5P_DEFAULT) <= 0) 
+    check(-1, DMESG("Input file " + fileIO->inputFileName + " has no /Grid group, which is required for interpolation"));
+
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Nx" , &Nx_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Nky", &Nky_in), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Nz" , &Nz_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Nv" , &Nv_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Nm" , &Nm_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_int   (file_in, "/Grid", "Ns" , &Ns_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_double(file_in, "/Grid", "Lx" , &Lx_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_double(file_in, "/Grid", "Ly" , &Ly_in ), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_double(file_in, "/Grid", "Lz" , &Lz_in ), DMESG("H5LTget_attribute"));
+
+  check(((Ns_in != Ns) || (Nm_in != Nm)) ? -1 : 0, DMESG("Interpolation requires same number of species and μ-points"));
+  check(((std::abs(Lx_in - Lx) > 1.e-10 * Lx) || (std::abs(Ly_in - Ly) > 1.e-10 * Ly)) ? -1 : 0, 
+        DMESG("Interpolation requires same Lx and Ly"));
+
+  std::vector<double> X_in(Nx_in), Z_in(Nz_in), V_in(Nv_in);
+  check(H5LTget_attribute_double(file_in, "/Grid", "X", X_in.data()), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_double(file_in, "/Grid", "Z", Z_in.data()), DMESG("H5LTget_attribute"));
+  check(H5LTget_attribute_double(file_in, "/Grid", "V", V_in.data()), DMESG("H5LTget_attribute"));
+
+  const int order = setup->get("DataOutput.InterpolationOrder", 4);
+
+  // x is interpolated at the grid points (including the shift of Grid.IncludeX0Point of both grids), 
+  // z is periodic (stencil wraps around), f is zero outside of velocity domain
+  const double dx_in = (Nx_in > 1) ? X_in[1] - X_in[0] : Lx_in;
+
+  SpectralInterpolation intX(Nx_in, X_in[0], dx_in, Nx, &X[NxLlD], NxLD);
+  LagrangeInterpolation intZ(Z_in.data(), Nz_in, &Z[NzLlD], NzLD, order, true , Lz_in);
+  LagrangeInterpolation intV(V_in.data(), Nv_in, &V[NvLlD], NvLD, order, false);
+
+  // k_y modes are truncated or zero-padded
+  const int Nky_r = std::min(Nky_in, Nky);
+
+  hid_t dset_f0 = check(H5Dopen(file_in, "/Vlasov/f0", H5P_DEFAULT), DMESG("H5Dopen"));
+  hid_t dset_f1 = check(H5Dopen(file_in, "/Vlasov/f1", H5P_DEFAULT), DMESG("H5Dopen"));
+
+  // use last time step of f0 and slot (or last time step) of f1
+  hsize_t dim_f0[6], dim_f1[7];
+  hid_t dspace;
+  dspace = H5Dget_space(dset_f0); H5Sget_simple_extent_dims(dspace, dim_f0, NULL); H5Sclose(dspace);
+  dspace = H5Dget_space(dset_f1); H5Sget_simple_extent_dims(dspace, dim_f1, NULL); H5Sclose(dspace);
+
+  const hsize_t t_f0 = dim_f0[5] - 1, t_f1 = (slot >= 0) ? slot : dim_f1[6] - 1;
+
+  std::vector<double>   in_f0(NzLD *         NxLD * NvLD);
+  std::vector<CComplex> in_f1(NzLD * Nky_r * NxLD * NvLD);
+
+  for(int s = NsLlD; s <= NsLuD; s++) { for(int m = NmLlD; m <= NmLuD; m++) {
+
+    interpolateBlock(dset_f0, H5T_NATIVE_DOUBLE   , 6, t_f0, s, m, 1    , Nx_in, Nz_in, intX, intZ, intV, in_f0.data());
+    interpolateBlock(dset_f1, fileIO->complex_tid, 7, t_f1, s, m, Nky_r, Nx_in, Nz_in, intX, intZ, intV, in_f1.data());
+
+    [=](double         f0   [NsLD][NmLB][NzLB]       [NxLB][NvLB],
+        PComplex       f    [NsLD][NmLB][NzLB][Nky  ][NxLB][NvLB],
+        const double   in_f0            [NzLD]       [NxLD][NvLD],
+        const CComplex in_f1            [NzLD][Nky_r][NxLD][NvLD])
+    {
+      for(int z = NzLlD; z <= NzLuD; z++) { for(int x = NxLlD; x <= NxLuD; x++) {
+
+        f0[s][m][z][x][NvLlD:NvLD] = in_f0[z-NzLlD][x-NxLlD][:];
+
+        for(int y_k = 0; y_k < Nky; y_k++) { simd_for(int v = NvLlD; v <= NvLuD; v++) {
+
+          f[s][m][z][y_k][x][v] = (y_k < Nky_r) ? in_f1[z-NzLlD][y_k][x-NxLlD][v-NvLlD] : 0.;
+
+        } } // y_k, v
+      } } // z, x
+
+    } ((A5rr) f0, (A6pp) f, (A3rr) in_f0.data(), (A4zz) in_f1.data());
+
+  } } // s, m
+
+  H5Dclose(dset_f0);
+  H5Dclose(dset_f1);
+}
+
+void Vlasov::writeCheckpoint(const Timing &timing)
+{
+  // overwrite oldest slot, thus last checkpoint stays valid until new one is complete
+  const int slot = (checkpointSlot + 1) % checkpointSlots;
+
+  // Maxwellian is time-independent
+  if(!checkpointF0) { FA_chk_f0->writeAt(ArrayF0.data(f0), 0); checkpointF0 = true; }
+
+  FA_chk_f1->writeAt(ArrayPhase.data(f), slot);
+
+  // switch to new slot after data is on disk (queued after write if output is asynchronous)
+  const hid_t  file = checkpointFile;
+  const int    step = timing.step;
+  const double time = timing.time;
+
+  AsyncIO::submit([=] {
+
+    check(H5Fflush(file, H5F_SCOPE_GLOBAL), DMESG("H5Fflush"));
+
+    check(H5LTset_attribute_int   (file, "/Vlasov", "Slot"    , &slot, 1), DMESG("H5LTset_attribute"));
+    check(H5LTset_attribute_int   (file, "/Vlasov", "Timestep", &step, 1), DMESG("H5LTset_attribute"));
+    check(H5LTset_attribute_double(file, "/Vlasov", "Time"    , &time, 1), DMESG("H5LTset_attribute"));
+
+    check(H5Fflush(file, H5F_SCOPE_GLOBAL), DMESG("H5Fflush"));
+  });
+
+  checkpointSlot = slot;
+  
+  parallel->print("Wrote checkpoint to slot " + Setup::num2str(slot) + " ... "); 
 }
 
 
@@ -322,5 +762,9 @@ void Vlasov::printOn(std::ostream &output) const
   output << "Vlasov     | Hyperviscosity [ " ;
   for(int dir = DIR_X; dir <= DIR_S; dir++) output << hyp_visc[dir] << " ";
   output << " ] " << std::endl;
+  
+  const nct::alloc_registry &reg = nct::allocate::registry();
+  output << "Vlasov     | First-touch : " << (useNUMA ? "yes" : "no") 
+         << " (" << reg.bytesFirstTouch/(1 << 20) << " MB)  Huge pages : " << reg.bytesHugePages/(1 << 20) << " MB" << std::endl;
 }
 
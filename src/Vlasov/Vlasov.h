@@ -66,7 +66,7 @@ class Vlasov : public IfaceGKC {
   /**
   *  @brief Buffers for exchanging ghost cells in each direction
   */ 
-  CComplex *SendXl,  ///< Send Buffer in X-direction (send to down)
+  PComplex *SendXl,  ///< Send Buffer in X-direction (send to down)
            *SendXu,  ///< Send buffer in X-direction (send to up)
            *SendZl,  ///< Send buffer in Z-direction (send to down)
            *SendZu,  ///< Send buffer in Z-direction (send to up) 
@@ -145,15 +145,25 @@ class Vlasov : public IfaceGKC {
   *
   *  set fs to const f_in 
   **/
-  virtual void solve(std::string equation_type, Fields *fields, CComplex *fs, CComplex *fss, 
+  virtual void solve(std::string equation_type, Fields *fields, PComplex *fs, PComplex *fss, 
                      double dt, int rk_step, const double rk[3]) = 0;
    
   Timing dataOutputF1; ///< Timing to output whole phase distribution function
 
+  Scheduler::Task *taskF1; ///< Scheduled output of phase distribution function
+
+  Timing dataOutputCheckpoint; ///< Timing to write checkpoint
+
+  Timing dataOutputRaw; ///< Timing to write raw snapshot (see RawSnapshot)
+
 
  public:
   
   bool doNonLinear; ///< set if non-linear simulations are performed
+
+  bool doCollisions; ///< set if collision operator is used
+
+  bool useNUMA;      ///< set if phase space is allocated with first-touch and huge pages
   bool doNonLinearParallel; ///< Calculate the parallel non-linearity
   bool removeZF; ///< remove zonal flows
        
@@ -197,6 +207,7 @@ class Vlasov : public IfaceGKC {
   *
   **/
   nct::allocate ArrayPhase, ///< Allocator distribution functions
+                ArrayF0   , ///< Allocator for Maxwellian
                 ArrayG    , ///< Allocation class for G
                 ArrayXi   , ///< Allocation class for Xi
                 ArrayNL   , ///< Allocation class for non-linear term
@@ -207,14 +218,20 @@ class Vlasov : public IfaceGKC {
   *
   *
   **/
-  CComplex *f0,         ///< Maxwellian 
-           *f ,         ///< Perturbed Phase Space Function
+  PComplex *f ,         ///< Perturbed Phase Space Function
            *fs,         ///< Temporary for time step integration
            *fss,        ///< 
-           *ft,         ///< 
-           *f1,         ///< f1
-           *Coll;       ///< Collisional corrections
+           *ft;         ///< 
    
+  /**
+  *   @brief Maxwellian background f0[s][m][z][x][v]
+  *
+  *   The background is real and independent of \f$ k_y \f$ and thus
+  *   stored without the \f$ k_y \f$ dimension.
+  *
+  **/
+  double *f0;
+
   /**
   *    Please Document Me !
   *
@@ -244,7 +261,7 @@ class Vlasov : public IfaceGKC {
   *  Handles boundary conditions
   *
   **/
-  void solve(Fields *fields, CComplex *fs, CComplex *fss, double dt, 
+  void solve(Fields *fields, PComplex *fs, PComplex *fss, double dt, 
              int rk_step, const double rk[3],  bool useNonBlockingBoundary=true);
 
   /**
@@ -253,10 +270,10 @@ class Vlasov : public IfaceGKC {
   *
   *
   **/
-  void setBoundary(CComplex *f);
+  void setBoundary(PComplex *f);
 
 
-  void setBoundary(CComplex *f, const Boundary boundary_type);
+  void setBoundary(PComplex *f, const Boundary boundary_type);
 
   /**
   *    Please Document Me !
@@ -325,6 +342,83 @@ class Vlasov : public IfaceGKC {
            *FA_f0,      ///< Data output for Maxwellian
            *FA_psfTime; ///< Data output for time step writes
 
+  /**
+  *   @brief Rotating checkpoint slots (DataOutput.Checkpoint)
+  *
+  *   Instead of appending the phase space to the output file, f1 is 
+  *   written into one of a fixed number of slots in a separate restart 
+  *   file (f0 is written once). The "Slot" attribute of /Vlasov points
+  *   to the last complete checkpoint and is only updated after the data
+  *   has been flushed, thus an interrupted write never invalidates the 
+  *   previous checkpoint. Setup parameters are
+  *
+  *     DataOutput.Checkpoint.Slots    : number of slots (default 0, disabled)
+  *     DataOutput.Checkpoint.Step     : write checkpoint every n-th step
+  *     DataOutput.Checkpoint.Time     : write checkpoint in time intervals
+  *     DataOutput.Checkpoint.FileName : restart file (default restart.h5), reused
+  *                                      if simulation is resumed from it
+  *
+  **/
+  int checkpointSlots,     ///< number of slots (0 : no checkpoints)
+      checkpointSlot;      ///< slot of last written checkpoint (-1 : none)
+
+  bool checkpointF0;       ///< true if Maxwellian is written to restart file
+
+  hid_t checkpointFile;    ///< HDF-5 id of restart file
+
+  FileAttr *FA_chk_f1,     ///< Checkpoint slots of phase-space function
+           *FA_chk_f0;     ///< Maxwellian of checkpoint 
+
+  /**
+  *   @brief write phase space to next checkpoint slot
+  *
+  **/
+  void writeCheckpoint(const Timing &timing);
+
+  /**
+  *   Raw snapshots are written every DataOutput.RawSnapshot.Step/Time to
+  *   <DataOutput.RawSnapshot.Prefix>.<rank>.raw and read for restart
+  *   from DataOutput.RawSnapshot.Input (prefix).
+  *
+  **/
+  std::string rawPrefix; ///< prefix of raw snapshot files
+
+  /**
+  *   @brief write local f0 and f1 to raw per-process file (see RawSnapshot)
+  *
+  *   No HDF-5 or collective operations are involved, files can be converted
+  *   to the HDF-5 layout using gkc-raw2h5.
+  *
+  **/
+  void writeRawSnapshot(const Timing &timing);
+
+  /**
+  *   @brief read local f0 and f1 from raw per-process file
+  *
+  *   Collective, the snapshot is only used if the files of all processes
+  *   exist, match the decomposition/grid and are of the same time step.
+  *
+  *   @return false if any file does not exist, does not match or time steps differ
+  *
+  **/
+  bool readRawSnapshot(const std::string prefix);
+
+  /**
+  *   @brief read f0 and f1 from input file of different resolution
+  *
+  *   Interpolates spectrally in x (periodic over Nx points as used by the
+  *   FFT solver) and k_y (truncation or zero-padding of modes), and by
+  *   Lagrange polynomials of order DataOutput.InterpolationOrder in z 
+  *   (periodic) and v. Interpolation uses the grid points of the input file,
+  *   thus grids may differ in Grid.IncludeX0Point. Number of species and μ-points, as well as Lx and Ly have to match.
+  *
+  *   @param file_in input file
+  *   @param fileIO  required for complex data type
+  *   @param slot    time index of f1 (-1 for last)
+  *
+  **/
+  void readInterpolated(hid_t file_in, FileIO *fileIO, const int slot);
+
 };
 
 
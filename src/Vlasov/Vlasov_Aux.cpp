@@ -13,6 +13,7 @@
  */
 
 #include "Vlasov/Vlasov_Aux.h"
+#include "Tools/ScratchArena.h"
 
 
   
@@ -27,27 +28,27 @@ VlasovAux::VlasovAux(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *_f
 }
 
 
-void VlasovAux::solve(std::string equation_type, Fields *fields, CComplex *f_in, CComplex *f_out, double dt, int rk_step, const double rk[3]) 
+void VlasovAux::solve(std::string equation_type, Fields *fields, PComplex *f_in, PComplex *f_out, double dt, int rk_step, const double rk[3]) 
 {
 
   // do I need both, we can stick to e-m ? Speed penality ?
   
   if(equation_type == "ES")
 
-      Vlasov_ES   ((A6zz) f_in, (A6zz) f_out     , (A6zz) f0, (A6zz) f, 
-                   (A6zz) ft , (A6zz) Coll, (A6zz) fields->Field, 
+      Vlasov_ES   ((A6pp) f_in, (A6pp) f_out     , (A5rr) f0, (A6pp) f, 
+                   (A6pp) ft , (A6zz) fields->Field, 
                    (A3zz) nonLinearTerm, X, V, M, dt, rk_step, rk);
 
   else if(equation_type == "EM")
 
-      Vlasov_EM   ((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f,
-                   (A6zz) ft, (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_EM   ((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f,
+                   (A6pp) ft, (A6zz) fields->Field, (A3zz) nonLinearTerm,
                    (A4zz) Xi, (A4zz) G, dt, rk_step, rk);
 
   else if(equation_type == "Landau_Damping")
     
-      Landau_Damping((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, 
-                     (A6zz) ft , (A6zz) fields->Field, 
+      Landau_Damping((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, 
+                     (A6pp) ft , (A6zz) fields->Field, 
                       X, V, M, dt, rk_step, rk);
   
   else   check(-1, DMESG("No Such Equation"));
@@ -58,12 +59,11 @@ void VlasovAux::solve(std::string equation_type, Fields *fields, CComplex *f_in,
 
 
 void VlasovAux::Vlasov_ES(
-                           const CComplex fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss             [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft              [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss             [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0        [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft              [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLB][NzLB][Nky][NxLB+4],
                            CComplex       nonLinearTerm               [Nky][NxLD  ][NvLD],
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
@@ -122,7 +122,7 @@ void VlasovAux::Vlasov_ES(
          //#pragma vector nontemporal(fss)
   simd_for(int v = NvLlD; v <= NvLuD; v++) { 
            
-    const  CComplex f0_    = f0 [s][m][z][y_k][x][v];
+    const double   f0_    = f0 [s][m][z][x][v];
 
     const  CComplex g      = fs [s][m][z][y_k][x][v];
        
@@ -133,8 +133,7 @@ void VlasovAux::Vlasov_ES(
       -  nonLinearTerm[y_k][x][v]                                                   // Non-linear ( array is zero for linear simulations) 
       -  ky* ((w_n + w_T * (((V[v]*V[v])+ (doGyro ? M[m] : 0.))*kw_T  - sub)) * f0_ * phi_    // Driving term (Temperature/Density gradient)
       +  half_eta_kperp2_phi * f0_)                                            // Contributions from gyro-1 (0 if not neq Gyro-1)
-      -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                        // Linear Landau damping
-      +  Coll[s][m][z][y_k][x][v]  ;                                           // Collisional operator
+      -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_);                       // Linear Landau damping
          
     //////////////////////////////////////////////////////////////////////////////////////////////////////
         
@@ -151,12 +150,11 @@ void VlasovAux::Vlasov_ES(
 
 
 void VlasovAux::Vlasov_EM(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex    nonLinearTerm               [Nky][NxLD  ][NvLD],
                            CComplex Xi       [NzLB][Nky][NxLB+4][NvLB],
@@ -204,7 +202,7 @@ void VlasovAux::Vlasov_EM(
       const CComplex kp = geo->get_kp(x, ky, z);
 
       const CComplex g    = fs[s][m][z][y_k][x][v];
-      const CComplex F0   = f0[s][m][z][y_k][x][v];
+      const double   F0   = f0[s][m][z][x][v];
 
       const CComplex G_   =  G[z][y_k][x][v];
       const CComplex Xi_  = Xi[z][y_k][x][v];
@@ -227,8 +225,7 @@ void VlasovAux::Vlasov_EM(
     +  nonLinearTerm[y_k][x][v]                                             // Non-linear ( array is zero for linear simulations) 
     +  ky* (-(w_n + w_T * (((V[v]*V[v])+ M[m])/Temp  - sub)) * F0 * Xi_     // Driving term (Temperature/Density gradient)
     -  half_eta_kperp2_Xi * F0)                                             // Contributions from gyro-1 (0 if not neq Gyro-1)
-    -  alpha  * V[v]* kp  * G_                                              // Linear Landau damping
-    +  Coll[s][m][z][y_k][x][v]  ;                                          // Collisional operator
+    -  alpha  * V[v]* kp  * G_;                                             // Linear Landau damping
          
         
     //////////////////////////// Vlasov End ////////////////////////////
@@ -245,11 +242,11 @@ void VlasovAux::Vlasov_EM(
 }
 
 void VlasovAux::Landau_Damping(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Field::phi][NsLD][NmLD][NzLB][Nky][NxLB+4],
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
                            const double dt, const int rk_step, const double rk[3])
@@ -262,7 +259,7 @@ void VlasovAux::Landau_Damping(
          for(int z=NzLlD; z<= NzLuD;z++) {       for(int y_k=NkyLlD; y_k<= NkyLuD;y_k++) {
          for(int x=NxLlD; x<= NxLuD;x++) {  simd_for(int v=NvLlD; v<= NvLuD;v++)         {
        
-           const CComplex f0_     = f0 [s][m][z][y_k][x][v];
+           const double   f0_     = f0 [s][m][z][x][v];
 
            const CComplex dphi_dx = (8.*(Fields[Field::phi][s][m][z][y_k][x+1] - Fields[Field::phi][s][m][z][y_k][x-1]) 
                                       - (Fields[Field::phi][s][m][z][y_k][x+2] - Fields[Field::phi][s][m][z][y_k][x-2]))/(12.*dx)  ;  
@@ -291,7 +288,7 @@ void VlasovAux::Landau_Damping(
 
 
 void VlasovAux::calculateParallelNonLinearity(
-                                const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                                const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                                 const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of e-s
                                 const int z, const int m, const int s                     ,
                                 CComplex nonLinearTerm[Nky][NxLD][NvLD])
@@ -330,7 +327,7 @@ void VlasovAux::calculateParallelNonLinearity(
 };
 
 void VlasovAux::calculateParallelNonLinearity2(
-                                const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                                const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                                 const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4], 
                                 const int z, const int m, const int s                    ,
                                 CComplex nonLinearTerm[Nky][NxLD][NvLD])
@@ -343,9 +340,15 @@ void VlasovAux::calculateParallelNonLinearity2(
 
   // Note : we do not use any anti-aliasing method here!
 
-  CComplex Arr_NkyNx[Nky][NxLD], NL_NxNky[Nky][NxLD];
+  // thread local temporary arrays, released at end of scope
+  ScratchArena::Frame frame;
+
+  CComplex (*Arr_NkyNx)[NxLD] = (CComplex (*)[NxLD]) ScratchArena::get<CComplex>(Nky * NxLD),
+           (*NL_NxNky )[NxLD] = (CComplex (*)[NxLD]) ScratchArena::get<CComplex>(Nky * NxLD);
   
-  doubleAA xy_phi_kp[NyLD][NxLD], xy_dg_dv[NyLD][NxLD], NL_NxNy[NyLD][NxLD];
+  double (*xy_phi_kp)[NxLD] = (double (*)[NxLD]) ScratchArena::get<double>(NyLD * NxLD),
+         (*xy_dg_dv )[NxLD] = (double (*)[NxLD]) ScratchArena::get<double>(NyLD * NxLD),
+         (*NL_NxNy  )[NxLD] = (double (*)[NxLD]) ScratchArena::get<double>(NyLD * NxLD);
 
   for(int y_k = NkyLlD; y_k <= NkyLuD; y_k++) {  for(int x = NxLlD; x <= NxLuD; x++) { 
  
@@ -357,7 +360,7 @@ void VlasovAux::calculateParallelNonLinearity2(
 
   } }
 
-  fft->solve(FFT_Type::Y_NL, FFT_Sign::Backward, (CComplex *) Arr_NkyNx, &xy_phi_kp);
+  fft->solve(FFT_Type::Y_NL, FFT_Sign::Backward, (CComplex *) Arr_NkyNx, xy_phi_kp);
 
   for(int v = NvLlD; v <= NvLuD; v++) {
 
@@ -368,14 +371,14 @@ void VlasovAux::calculateParallelNonLinearity2(
  
   } } // y_k, x
   
-  fft->solve(FFT_Type::Y_NL, FFT_Sign::Backward, (CComplex *) Arr_NkyNx, &xy_dg_dv);
+  fft->solve(FFT_Type::Y_NL, FFT_Sign::Backward, (CComplex *) Arr_NkyNx, xy_dg_dv);
 
   // multiply non-linear terms
-  NL_NxNy[:][:] = _kw_fft_Norm * half_vth_kw_T * xy_phi_kp[:][:] * xy_dg_dv[:][:] ;
+  NL_NxNy[0:NyLD][:] = _kw_fft_Norm * half_vth_kw_T * xy_phi_kp[0:NyLD][:] * xy_dg_dv[0:NyLD][:] ;
    
   fft->solve(FFT_Type::Y_NL, FFT_Sign::Forward, NL_NxNy, (CComplex *) NL_NxNky);
 
-  nonLinearTerm[:][NxLlD:NxLD][v] -= NL_NxNky[:][:]; 
+  nonLinearTerm[:][NxLlD:NxLD][v] -= NL_NxNky[0:Nky][:]; 
   
   } // v
 
@@ -73,12 +73,11 @@ class VlasovAux : public VlasovCilk {
    *
    **/
    void    Vlasov_ES(
-                           const CComplex  fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex  f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex  f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex  fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex  f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
                            CComplex nonLinear                  [Nky][NxLD  ][NvLD],
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
@@ -88,12 +87,11 @@ class VlasovAux : public VlasovCilk {
    *
    **/
    void Vlasov_EM(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex    nonLinear               [Nky][NxLD  ][NvLD],
                            CComplex Xi       [NzLB][Nky][NxLB][NvLB],
@@ -106,11 +104,11 @@ class VlasovAux : public VlasovCilk {
    *
    **/
    void  Landau_Damping(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Field[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
                            const double dt, const int rk_step, const double rk[3]);
@@ -130,13 +128,13 @@ class VlasovAux : public VlasovCilk {
    *
    **/
    void calculateParallelNonLinearity(
-                                const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                                const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                                 const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of e-s
                                 const int z, const int m, const int s                     ,
                                 CComplex NonLinearTerm[Nky][NxLD][NvLD]);
    
    void calculateParallelNonLinearity2(
-                                const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                                const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                                 const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of e-s
                                 const int z, const int m, const int s                     ,
                                 CComplex NonLinearTerm[Nky][NxLD][NvLD]);
@@ -154,7 +152,7 @@ class VlasovAux : public VlasovCilk {
    *    Please Document Me !
    *
    **/
-   void solve(std::string equation_tyoe, Fields *fields, CComplex *fs, CComplex *fss, 
+   void solve(std::string equation_tyoe, Fields *fields, PComplex *fs, PComplex *fss, 
               double dt, int rk_step, const double rk[3]);
  
   protected :
@@ -14,6 +14,7 @@
 
 
 #include "Vlasov_Cilk.h"
+#include "Tools/ScratchArena.h"
 
 
 VlasovCilk::VlasovCilk(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *fileIO, Geometry *_geo, FFTSolver *fft, Benchmark *_bench, Collisions *_coll)    
@@ -23,12 +24,12 @@ VlasovCilk::VlasovCilk(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO *
 }
 
 
-void VlasovCilk::solve(std::string equation_type, Fields *fields, CComplex *f_in, CComplex *f_out, 
+void VlasovCilk::solve(std::string equation_type, Fields *fields, PComplex *f_in, PComplex *f_out, 
                        double dt, int rk_step, const double rk[3]) 
 {
 
   if(0);
-  else if(equation_type == "EM") Vlasov_EM((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, (A6zz) ft, (A6zz) Coll, 
+  else if(equation_type == "EM") Vlasov_EM((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, (A6pp) ft, 
                                            (A6zz) fields->Field, (A4zz) Xi, (A4zz) G, (A3zz) nonLinearTerm,
                                            (A2rr) geo->Kx, (A2rr) geo->Ky, (A2rr) geo->dB_dz,
                                            dt, rk_step, rk);
@@ -55,11 +56,11 @@ void VlasovCilk::solve(std::string equation_type, Fields *fields, CComplex *f_in
 // __BIGGEST_ALIGNMENT automatically uses max alignments sizes supported by vector instructions
 // take care, for electro-static simulations, G & Xi are null pointers (for em &phi respectively)
 //
-// Take care that OMP_STACKSIZE is large enough in case of thread parallelization
+// Temporary arrays are taken from the thread-local scratch arena (not the stack)
 //
 void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][Nky][NxLB  ][NvLB],  // in case of em
                                          const CComplex Xi              [NzLB][Nky][NxLB+4][NvLB],  // in case of em
-                                         const CComplex  f [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // in case of es
+                                         const PComplex  f [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // in case of es
                                          const CComplex Fields[Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of es
                                          const int z, const int m, const int s,
                                          CComplex ExB[Nky][NxLD][NvLD], double Xi_max[3], const bool electroMagnetic)
@@ -70,18 +71,24 @@ void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][
   const doubleAA _kw_12_dx  = 1./(12.*dx), _kw_12_dy=1./(12.*dy);
   const doubleAA _kw_24_dx  = 1./(24.*dx), _kw_24_dy=1./(24.*dy);
       
-  CComplexAA  xky_Xi [Nky][NxLB+4];
-  CComplexAA  xky_f1 [Nky][NxLB  ];
-  CComplexAA  xky_ExB[Nky][NxLD  ];
+  // thread local temporary arrays, released at end of scope
+  ScratchArena::Frame frame;
+      
+  CComplex (*xky_Xi )[NxLB+4] = (CComplex (*)[NxLB+4]) ScratchArena::get<CComplex>(Nky * (NxLB+4));
+  CComplex (*xky_f1 )[NxLB  ] = (CComplex (*)[NxLB  ]) ScratchArena::get<CComplex>(Nky * (NxLB  ));
+  CComplex (*xky_ExB)[NxLD  ] = (CComplex (*)[NxLD  ]) ScratchArena::get<CComplex>(Nky * (NxLD  ));
+
+  // pruned spectral band, modes outside are zero (input) or dropped (output)
+  const int NkyI = fft->Y_NkyIn, NkyO = fft->Y_NkyOut;
 
-  doubleAA    xy_Xi    [NyLD+8][NxLB+4]; // extended BC 
-  doubleAA    xy_dXi_dy[NyLD+4][NxLB  ]; // normal BC
-  doubleAA    xy_dXi_dx[NyLD+4][NxLB  ];
-  doubleAA    xy_f1    [NyLD+4][NxLB  ];
-  doubleAA    xy_ExB   [NyLD  ][NxLD  ];
+  double (*xy_Xi    )[NxLB+4] = (double (*)[NxLB+4]) ScratchArena::get<double>((NyLD+8) * (NxLB+4)); // extended BC 
+  double (*xy_dXi_dy)[NxLB  ] = (double (*)[NxLB  ]) ScratchArena::get<double>((NyLD+4) * (NxLB  )); // normal BC
+  double (*xy_dXi_dx)[NxLB  ] = (double (*)[NxLB  ]) ScratchArena::get<double>((NyLD+4) * (NxLB  ));
+  double (*xy_f1    )[NxLB  ] = (double (*)[NxLB  ]) ScratchArena::get<double>((NyLD+4) * (NxLB  ));
+  double (*xy_ExB   )[NxLD  ] = (double (*)[NxLD  ]) ScratchArena::get<double>((NyLD  ) * (NxLD  ));
 
   bool have_xy_dXi = false; // need for OpenMP parallelization over v
-                            //  as all variables are on stack and thread local
+                            //  as all temporary variables are thread local
 
   #pragma omp for
   for(int v = NvLlD; v <= NvLuD; v++) { 
@@ -92,8 +99,11 @@ void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][
     // for electro-static field this has to be calculated only once
     if(electroMagnetic || !have_xy_dXi) {
 
-      if(electroMagnetic) xky_Xi[:][:] =     Xi                  [z][:][NxLlB-2:NxLB+4][v];
-      else                xky_Xi[:][:] = Fields[Field::phi][s][m][z][:][NxLlB-2:NxLB+4]   ;
+      if(electroMagnetic) xky_Xi[0:NkyI][:] =     Xi                  [z][0:NkyI][NxLlB-2:NxLB+4][v];
+      else                xky_Xi[0:NkyI][:] = Fields[Field::phi][s][m][z][0:NkyI][NxLlB-2:NxLB+4]   ;
+      
+      // c2r transform destroys its input, thus pruned modes are reset for each transform
+      xky_Xi[NkyI:Nky-NkyI][:] = 0.;
        
       // xy_Xi[shift by +4][], as we also will use extended BC in Y
       // xy_Xi[Nky][:] = 0.; // we do not include Nyquist frequency
@@ -113,8 +123,8 @@ void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][
       
       // get maximum partial_nu chi value to calculate CFL condition
       {
-        const double max_dXi_dx =  __sec_reduce_max(cabs(xy_dXi_dx[:][:]));
-        const double max_dXi_dy =  __sec_reduce_max(cabs(xy_dXi_dy[:][:]));
+        const double max_dXi_dx =  __sec_reduce_max(cabs(xy_dXi_dx[0:NyLD+4][:]));
+        const double max_dXi_dy =  __sec_reduce_max(cabs(xy_dXi_dy[0:NyLD+4][:]));
 
         // possible to replace with atomic capture in OpenMP 4.0
         #pragma omp critical
@@ -128,8 +138,10 @@ void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][
       have_xy_dXi = true; 
     }
 
-    if(electroMagnetic) xky_f1[:][:] = G      [z][0:Nky][NxLlB:NxLB][v];
-    else                xky_f1[:][:] = f[s][m][z][0:Nky][NxLlB:NxLB][v];
+    if(electroMagnetic) xky_f1[0:NkyI][:] = G      [z][0:NkyI][NxLlB:NxLB][v];
+    else                xky_f1[0:NkyI][:] = f[s][m][z][0:NkyI][NxLlB:NxLB][v];
+    
+    xky_f1[NkyI:Nky-NkyI][:] = 0.;
 
     fft->solve(FFT_Type::Y_PSF, FFT_Sign::Backward, (CComplex *) xky_f1, &xy_f1[2][0]);
 
@@ -159,14 +171,15 @@ void VlasovCilk::calculateExBNonLinearity(const CComplex  G              [NzLB][
 
     fft->solve(FFT_Type::Y_NL, FFT_Sign::Forward, xy_ExB, (CComplex *) xky_ExB);
 
-    // Done - store the non-linear term in ExB
-    ExB[0:Nky][NxLlD:NxLD][v] = xky_ExB[:][:];
+    // Done - store the non-linear term in ExB (only active modes)
+    ExB[0   :NkyO    ][NxLlD:NxLD][v] = xky_ExB[0:NkyO][:];
+    ExB[NkyO:Nky-NkyO][NxLlD:NxLD][v] = 0.;
   }
 }
                            
 void VlasovCilk::setupXiAndG(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex Xi                           [NzLB][Nky][NxLB+4][NvLB],
                            CComplex G                            [NzLB][Nky][NxLB  ][NvLB],
@@ -193,7 +206,7 @@ void VlasovCilk::setupXiAndG(
      Xi[z][y_k][x][v] = Fields[Field::phi][s][m][z][y_k][x] - (useAp ? aeb*V[v]*Fields[Field::Ap][s][m][z][y_k][x] : 0.) 
                                                             - (useBp ? aeb*M[m]*Fields[Field::Bp][s][m][z][y_k][x] : 0.);
 
-     G [z][y_k][x][v] = g[s][m][z][y_k][x][v]  + sigma * Xi[z][y_k][x][v] * f0[s][m][z][y_k][x][v];
+     G [z][y_k][x][v] = g[s][m][z][y_k][x][v]  + sigma * Xi[z][y_k][x][v] * f0[s][m][z][x][v];
 
      // subtract canonical momentum to get "real" f1 (not used "yet")
      // f1[z][y_k][x][v] = g[s][m][z][y_k][x][v] - (useAp ? saeb * V[v] * f0[s][n][z][y_k][x][v] * Ap[s][m][z][y_k][x] : 0.);
@@ -218,12 +231,11 @@ void VlasovCilk::setupXiAndG(
 
 
 void VlasovCilk::Vlasov_EM(
-    const CComplex g   [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Current step phase-space function
-    CComplex       h   [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Phase-space function for next step
-    const CComplex f0  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Background Maxwellian
-    const CComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // previous RK-Step
-    CComplex       ft  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // previous RK-Step
-    CComplex       Coll[NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Collisional corrections
+    const PComplex g   [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Current step phase-space function
+    PComplex       h   [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // Phase-space function for next step
+    const double   f0  [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],  // Background Maxwellian
+    const PComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // previous RK-Step
+    PComplex       ft  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],  // previous RK-Step
     const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
     CComplex Xi             [NzLB][Nky][NxLB+4][NvLB],
     CComplex G              [NzLB][Nky][NxLB  ][NvLB],
@@ -276,7 +288,7 @@ void VlasovCilk::Vlasov_EM(
   simd_for(int v = NvLlD; v <= NvLuD; v++) {
 
     const CComplex g_   =  g[s][m][z][y_k][x][v];
-    const CComplex f0_  = f0[s][m][z][y_k][x][v];
+    const double   f0_  = f0[s][m][z][x][v];
 
     const CComplex G_   =  G[z][y_k][x][v];
     const CComplex Xi_  = Xi[z][y_k][x][v];
@@ -308,11 +320,10 @@ void VlasovCilk::Vlasov_EM(
  //   - Bpre * sigma * ((M[m] * B0 + 2.*pow2(V[v]))/B0) *                                   
  //     (Kx[z][x] * dG_dx - Ky[z][x] * ky * G_)                                               // Magnetic curvature term
  //   + alpha * pow2(V[v]) * plasma->beta * plasma->w_p * G_ * ky                             // Plasma pressure gradient
-    - CoJB * alpha * V[v]* dG_dz                                                            // Linear Landau damping term
+    - CoJB * alpha * V[v]* dG_dz;                                                           // Linear Landau damping term
  //   + alpha  / 2. * M[m] * dB_dz[z][x] * dg_dv                                              // Magnetic mirror term    
 //    + Bpre *  sigma * (M[m] * B0 + 2. * pow2(V[v]))/B0 * Kx[z][x] * 
 //    + ((w_n + w_T * (pow2(V[v]) + M[m] * B0)/Temp - 3./2.) * dG_dx + sigma * dphi_dx * f0_) // ??
-    + Coll[s][m][z][y_k][x][v];                                                             // Collision term
           
     //////////////////////////// Vlasov End ////////////////////////////
 
@@ -343,7 +354,7 @@ void VlasovCilk::initData(Setup *setup, FileIO *fileIO)
 
    
 void VlasovCilk::calculateParallelNonLinearity(
-                                const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                                const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                                 const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4], 
                                 const int z, const int m, const int s                     ,
                                 CComplex NonLinearTerm[Nky][NxLD][NvLD])
@@ -353,35 +364,47 @@ void VlasovCilk::calculateParallelNonLinearity(
   
   const double _kw_fft_mass  = 1./species[s].m * _kw_fft;
 
-  CComplexAA  xky_dg_dv  [Nky][NxLB];
-  CComplexAA  xky_dphi_dz[Nky][NxLB];
-  CComplexAA  xky_v_NL   [Nky][NxLD];
+  // thread local temporary arrays, released at end of scope
+  ScratchArena::Frame frame;
+
+  CComplex (*xky_dg_dv  )[NxLB] = (CComplex (*)[NxLB]) ScratchArena::get<CComplex>(Nky * NxLB);
+  CComplex (*xky_dphi_dz)[NxLB] = (CComplex (*)[NxLB]) ScratchArena::get<CComplex>(Nky * NxLB);
+  CComplex (*xky_v_NL   )[NxLD] = (CComplex (*)[NxLD]) ScratchArena::get<CComplex>(Nky * NxLD);
+  
+  double (*xy_dg_dv  )[NxLB] = (double (*)[NxLB]) ScratchArena::get<double>((NyLD+4) * NxLB);
+  double (*xy_dphi_dz)[NxLB] = (double (*)[NxLB]) ScratchArena::get<double>((NyLD+4) * NxLB);
+  double (*xy_v_NL   )[NxLD] = (double (*)[NxLD]) ScratchArena::get<double>((NyLD  ) * NxLD);
   
-  doubleAA    xy_dg_dv  [NyLD+4][NxLB];
-  doubleAA    xy_dphi_dz[NyLD+4][NxLB];
-  doubleAA    xy_v_NL   [NyLD  ][NxLD];
+  // pruned spectral band, modes outside are zero (input) or dropped (output)
+  const int NkyI = fft->Y_NkyIn, NkyO = fft->Y_NkyOut;
+
+  xky_dphi_dz[NkyI:Nky-NkyI][:] = 0.;
  
   // phi
-  xky_dphi_dz[:][0:NxLB] = (8.*(Fields[Field::phi][s][m][z+1][:][NxLlB:NxLB] - Fields[Field::phi][s][m][z-1][:][NxLlB:NxLB]) 
-                            -  (Fields[Field::phi][s][m][z+2][:][NxLlB:NxLB] - Fields[Field::phi][s][m][z-2][:][NxLlB:NxLB])) * _kw_12_dz  ; 
+  xky_dphi_dz[0:NkyI][0:NxLB] = (8.*(Fields[Field::phi][s][m][z+1][0:NkyI][NxLlB:NxLB] - Fields[Field::phi][s][m][z-1][0:NkyI][NxLlB:NxLB]) 
+                                 -  (Fields[Field::phi][s][m][z+2][0:NkyI][NxLlB:NxLB] - Fields[Field::phi][s][m][z-2][0:NkyI][NxLlB:NxLB])) * _kw_12_dz  ; 
 
   fft->solve(FFT_Type::Y_PSF, FFT_Sign::Backward, xky_dphi_dz, &xy_dphi_dz[2][0]);
 
   #pragma omp for
   for(int v = NvLlD; v <= NvLuD; v++) { 
   
-   xky_dg_dv[:][0:NxLB]  = (8. *(f[s][m][z][:][NxLlB:NxLB][v+1] - f[s][m][z][:][NxLlB:NxLB][v-1]) 
-                              - (f[s][m][z][:][NxLlB:NxLB][v+2] - f[s][m][z][:][NxLlB:NxLB][v-2])) * _kw_12_dv;
+   xky_dg_dv[0:NkyI][0:NxLB]  = (8. *(f[s][m][z][0:NkyI][NxLlB:NxLB][v+1] - f[s][m][z][0:NkyI][NxLlB:NxLB][v-1]) 
+                                   - (f[s][m][z][0:NkyI][NxLlB:NxLB][v+2] - f[s][m][z][0:NkyI][NxLlB:NxLB][v-2])) * _kw_12_dv;
+   
+   // c2r transform destroys its input, thus pruned modes are reset for each transform
+   xky_dg_dv[NkyI:Nky-NkyI][:] = 0.;
     
    fft->solve(FFT_Type::Y_PSF, FFT_Sign::Backward, xky_dg_dv, &xy_dg_dv[2][0]);
   
    // Multiply in real space
-   xy_v_NL[:][:] = xy_dphi_dz[2:NyLD][2:NxLD] * xy_dg_dv[2:NyLD][2:NxLD] * _kw_fft_mass;
+   xy_v_NL[0:NyLD][:] = xy_dphi_dz[2:NyLD][2:NxLD] * xy_dg_dv[2:NyLD][2:NxLD] * _kw_fft_mass;
 
    fft->solve(FFT_Type::Y_NL, FFT_Sign::Forward, xy_v_NL, (CComplex *) xky_v_NL);
 
-   if(doNonLinear) NonLinearTerm[0:Nky][NxLlD:NxLD][v] += xky_v_NL[:][:] * _kw_fft_mass; 
-   else            NonLinearTerm[0:Nky][NxLlD:NxLD][v]  = xky_v_NL[:][:] * _kw_fft_mass;
+   if(doNonLinear) NonLinearTerm[0:NkyO][NxLlD:NxLD][v] += xky_v_NL[0:NkyO][:] * _kw_fft_mass; 
+   else          { NonLinearTerm[0:NkyO][NxLlD:NxLD][v]  = xky_v_NL[0:NkyO][:] * _kw_fft_mass;
+                   NonLinearTerm[NkyO:Nky-NkyO][NxLlD:NxLD][v] = 0.; }
   }
 }
 
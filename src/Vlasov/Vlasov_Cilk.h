@@ -87,7 +87,7 @@ class VlasovCilk : public Vlasov
   **/
   void calculateExBNonLinearity(const CComplex  G              [NzLB][Nky][NxLB  ][NvLB],   // in case of e-m
                                const CComplex Xi              [NzLB][Nky][NxLB+4][NvLB],   // in case of e-m
-                               const CComplex  f [NsLD][NmLD ][NzLB][Nky][NxLB  ][NvLB],   // in case of e-s
+                               const PComplex  f [NsLD][NmLD ][NzLB][Nky][NxLB  ][NvLB],   // in case of e-s
                                const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of e-s
                                const int z, const int m, const int s                     ,
                                CComplex ExB[Nky][NxLD][NvLD], double Xi_max[3], const bool electroMagnetic);
@@ -110,7 +110,7 @@ class VlasovCilk : public Vlasov
   *
   **/
   virtual void calculateParallelNonLinearity(
-                              const CComplex f          [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                              const PComplex f          [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                               const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4], // in case of e-s
                               const int z, const int m, const int s                     ,
                                CComplex NonLinearTerm[Nky][NxLD][NvLD]);
@@ -149,8 +149,8 @@ class VlasovCilk : public Vlasov
   *
   **/
   virtual void setupXiAndG(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
                                  CComplex Xi                     [NzLB][Nky][NxLB+4][NvLB],
                                  CComplex G                      [NzLB][Nky][NxLB  ][NvLB],
@@ -162,12 +162,11 @@ class VlasovCilk : public Vlasov
   *
   **/
   void Vlasov_EM(
-                           const CComplex fs         [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
-                           CComplex fss              [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
-                           const CComplex f1         [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
-                           CComplex ft               [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
-                           CComplex Coll             [NsLD][NmLD][NzLB][Nky][NxLB   ][NvLB],
+                           const PComplex fs         [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
+                           PComplex fss              [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB   ][NvLB],
+                           const PComplex f1         [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
+                           PComplex ft               [NsLD][NmLB][NzLB][Nky][NxLB   ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD ][NzLB][Nky][NxLB+4]      ,
                            CComplex Xi                            [NzLD][Nky][NxLB+4][NvLD],
                            CComplex G                             [NzLD][Nky][NxLD  ][NvLD],
@@ -205,7 +204,7 @@ class VlasovCilk : public Vlasov
   *    Please Document Me !
   *
   **/
-  virtual void solve(std::string equation_tyoe, Fields *fields, CComplex *fs, CComplex *fss,
+  virtual void solve(std::string equation_tyoe, Fields *fields, PComplex *fs, PComplex *fss,
                      double dt, int rk_step, const double rk[3]);
    
  protected :
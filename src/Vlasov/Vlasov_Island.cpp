@@ -123,38 +123,38 @@ VlasovIsland::VlasovIsland(Grid *_grid, Parallel *_parallel, Setup *_setup, File
 }
 
 
-void VlasovIsland::solve(std::string equation_type, Fields *fields, CComplex *f_in, CComplex *f_out, double dt, int rk_step, const double rk[3]) 
+void VlasovIsland::solve(std::string equation_type, Fields *fields, PComplex *f_in, PComplex *f_out, double dt, int rk_step, const double rk[3]) 
 {
   // do I need both, we can stick to e-m ? Speed penalty ?
   if(0) ;  
   else if(equation_type == "2D_Island") 
     
-      Vlasov_2D_Island((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, 
-                       (A6zz) ft  , (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_2D_Island((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, 
+                       (A6pp) ft  , (A6zz) fields->Field, (A3zz) nonLinearTerm,
                        MagIs, dMagIs_dx, X, V, M, (A3zz) Psi0, (A4zz) fields->Field0, dt, rk_step, rk);
   
   else if(equation_type == "2D_Island_Orig") 
     
-      Vlasov_2D_Island((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, 
-                       (A6zz) ft  , (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_2D_Island((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, 
+                       (A6pp) ft  , (A6zz) fields->Field, (A3zz) nonLinearTerm,
                        MagIs, dMagIs_dx, X, V, M, (A3zz) Psi0, (A4zz) fields->Field0, dt, rk_step, rk);
   
   else if(equation_type == "2D_Island_EM") 
     
-      Vlasov_2D_Island_EM   ((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f,
-                   (A6zz) ft, (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_2D_Island_EM   ((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f,
+                   (A6pp) ft, (A6zz) fields->Field, (A3zz) nonLinearTerm,
                    (A4zz) Xi, (A4zz) G, (A4zz) Xi_lin, (A4zz) G_lin, (A3zz) Psi0, (A4zz) fields->Field0, dt, rk_step, rk);
 
   else if(equation_type == "2D_Island_Filter") 
     
-      Vlasov_2D_Island_filter((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, 
-                       (A6zz) ft  , (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_2D_Island_filter((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, 
+                       (A6pp) ft  , (A6zz) fields->Field, (A3zz) nonLinearTerm,
                        MagIs, dMagIs_dx, X, V, M, dt, rk_step, rk);
 
   else if(equation_type == "2D_Island_Equi")
 
-      Vlasov_2D_Island_Equi((A6zz) f_in, (A6zz) f_out, (A6zz) f0, (A6zz) f, 
-                       (A6zz) ft  , (A6zz) Coll, (A6zz) fields->Field, (A3zz) nonLinearTerm,
+      Vlasov_2D_Island_Equi((A6pp) f_in, (A6pp) f_out, (A5rr) f0, (A6pp) f, 
+                       (A6pp) ft  , (A6zz) fields->Field, (A3zz) nonLinearTerm,
                        X, V, M, dt, rk_step, rk);
 
   else   check(-1, DMESG("No Such Equation"));
@@ -165,12 +165,11 @@ void VlasovIsland::solve(std::string equation_type, Fields *fields, CComplex *f_
 }
 
 void VlasovIsland::Vlasov_2D_Island(
-                           CComplex fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0  [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinearTerm                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs_dx[NxGB], 
@@ -265,7 +264,7 @@ void VlasovIsland::Vlasov_2D_Island(
   simd_for(int v = NvLlD; v <= NvLuD; v++) {
 
   const CComplex g   = fs[s][m][z][y_k][x][v];
-  const CComplex f0_ = f0[s][m][z][y_k][x][v];
+  const double   f0_ = f0[s][m][z][x][v];
 
       /////////////////////////////////////////////////// Magnetic Island Contribution    /////////////////////////////////////////
       
@@ -307,7 +306,6 @@ void VlasovIsland::Vlasov_2D_Island(
         phi_ 
         //(phi_ - (y_k == 1 ? Ap_ky * V[v] * MagIs[x] : 0.  )  )                 // Source term (Temperature/Density gradient)
     - alpha * V[v]* ikp  * ( g + sigma * phi_ * f0_)                 // Linear Landau damping
-    + Coll[s][m][z][y_k][x][v]                                        // Collisional operator
 ;//       +  hypvisc_xy        ;                                       // Hyperviscosity for stabilizing the scheme
          
         //////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -353,12 +351,11 @@ void VlasovIsland::printOn(std::ostream &output) const
 
 
 void VlasovIsland::Vlasov_2D_Island_Equi(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinearTerm                  [Nky][NxLD  ][NvLD],
                            const double X[NxGB+4], const double V[NvGB], const double M[NmGB],
@@ -409,7 +406,7 @@ void VlasovIsland::Vlasov_2D_Island_Equi(
         simd_for(int v=NvLlD; v<= NvLuD;v++) {
 
             const CComplex g    = fs[s][m][z][y_k][x][v];
-            const CComplex f0_  = f0[s][m][z][y_k][x][v];
+            const double   f0_  = f0[s][m][z][x][v];
 
 
         /////////////////////////////////////////////////// Magnetic Island Contribution    /////////////////////////////////////////
@@ -441,8 +438,7 @@ void VlasovIsland::Vlasov_2D_Island_Equi(
              +  nonLinearTerm[y_k][x][v]                                             // Non-linear ( array is zero for linear simulations) 
              +  ky* (-(w_n + w_T * (((V[v]*V[v])+ M[m])*kw_T  - sub)) * f0_ * phi_     // Driving term (Temperature/Density gradient)
              -  half_eta_kperp2_phi * f0_)                                            // Contributions from gyro-1 (0 if not neq Gyro-1)
-             -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                        // Linear Landau damping
-             +  Coll[s][m][z][y_k][x][v]  ;                                           // Collisional operator
+             -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_);                       // Linear Landau damping
          
         //////////////////////////////////////////////////////////////////////////////////////////////////////
         
@@ -461,12 +457,11 @@ void VlasovIsland::Vlasov_2D_Island_Equi(
 
 
 void VlasovIsland::Vlasov_2D_Island_filter(
-                           CComplex fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0  [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinearTerm                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs_dx[NxGB], 
@@ -575,7 +570,7 @@ void VlasovIsland::Vlasov_2D_Island_filter(
         simd_for(int v=NvLlD; v<= NvLuD;v++) {
 
             const CComplex g    = fs[s][m][z][y_k][x][v];
-            const CComplex f0_  = f0[s][m][z][y_k][x][v];
+            const double   f0_  = f0[s][m][z][x][v];
 
 
         /////////////////////////////////////////////////// Magnetic Island Contribution    /////////////////////////////////////////
@@ -643,7 +638,6 @@ void VlasovIsland::Vlasov_2D_Island_filter(
              +  ky* (-(w_n + w_T * (((V[v]*V[v])+ M[m])*kw_T  - sub)) * f0_ * phi_    // Driving term (Temperature/Density gradient)
              -  half_eta_kperp2_phi * f0_)                                            // Contributions from gyro-1 (0 if not neq Gyro-1)
              -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                        // Linear Landau damping
-             +  Coll[s][m][z][y_k][x][v]                                             // Collisional operator
              );
         //////////////////////////////////////////////////////////////////////////////////////////////////////
         
@@ -662,12 +656,11 @@ void VlasovIsland::Vlasov_2D_Island_filter(
 
 
 void VlasovIsland::Vlasov_2D_Island_EM(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex    nonLinearTerm               [Nky][NxLD  ][NvLD],
                            CComplex Xi       [NzLB][Nky][NxLB+4][NvLB],
@@ -733,7 +726,7 @@ void VlasovIsland::Vlasov_2D_Island_EM(
       const CComplex kp = geo->get_kp(x, ky, z);
 
       const CComplex g    = fs[s][m][z][y_k][x][v];
-      const CComplex f0_  = f0[s][m][z][y_k][x][v];
+      const double   f0_  = f0[s][m][z][x][v];
 
       const CComplex G_   =  G[z][y_k][x][v];
       const CComplex Xi_  = Xi[z][y_k][x][v];
@@ -749,8 +742,7 @@ void VlasovIsland::Vlasov_2D_Island_EM(
     -  ky* (w_n + w_T * ((V[v]*V[v]+ M[m])/Temp  - sub)) * f0_ *    // Driving term (Temperature/Density gradient)
         phi_                  // Source term (Temperature/Density gradient)
         //(phi_ - (y_k == 1 ? Ap_ky * V[v] * MagIs[x] : 0.  )  )                 // Source term (Temperature/Density gradient)
-    -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                    // Linear Landau damping
-    +  Coll[s][m][z][y_k][x][v]  ;                                       // Collisional operator
+    -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_);                   // Linear Landau damping
          
  
     //////////////////////////// Vlasov End ////////////////////////////
@@ -765,8 +757,8 @@ void VlasovIsland::Vlasov_2D_Island_EM(
 }
 
 void VlasovIsland::setupXiAndG_lin(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex Xi                           [NzLB][Nky][NxLB+4][NvLB],
                            CComplex G                            [NzLB][Nky][NxLB  ][NvLB],
@@ -791,7 +783,7 @@ void VlasovIsland::setupXiAndG_lin(
     // Magnetic Island
     Xi[z][y_k][x][v] = Phi0[z][y_k][x] - aeb*V[v]*Fields[Field::Ap][s][m][z][y_k][x]; 
 
-    G [z][y_k][x][v] = g[s][m][z][y_k][x][v] + sigma * Fields[Field::phi][s][m][z][y_k][x] * f0[s][m][z][y_k][x][v];
+    G [z][y_k][x][v] = g[s][m][z][y_k][x][v] + sigma * Fields[Field::phi][s][m][z][y_k][x] * f0[s][m][z][x][v];
 
   } } // v, x
      
@@ -811,12 +803,11 @@ void VlasovIsland::setupXiAndG_lin(
 
 /* 
 void VlasovIsland::Vlasov_2D_Island(
-                           CComplex fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0  [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinearTerm                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs_dx[NxGB], 
@@ -931,7 +922,7 @@ void VlasovIsland::Vlasov_2D_Island(
         simd_for(int v=NvLlD; v<= NvLuD;v++) {
 
             const CComplex g    = fs[s][m][z][y_k][x][v];
-            const CComplex f0_  = f0[s][m][z][y_k][x][v];
+            const double   f0_  = f0[s][m][z][x][v];
 
 
         /////////////////////////////////////////////////// Magnetic Island Contribution    /////////////////////////////////////////
@@ -977,8 +968,7 @@ void VlasovIsland::Vlasov_2D_Island(
 //                (phi_ - (y_k == 1 ? V[v] * MagIs[x] : 0.  )  ) )                       // Source term (Temperature/Density gradient)
              phi_)                        // Source term (Temperature/Density gradient)
      //        -  half_eta_kperp2_phi * f0_)                                            // Contributions from gyro-1 (0 if not neq Gyro-1)
-             -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                        // Linear Landau damping
-             +  Coll[s][m][z][y_k][x][v]  ;                                           // Collisional operator
+             -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_);                       // Linear Landau damping
          
         //////////////////////////////////////////////////////////////////////////////////////////////////////
         
@@ -997,12 +987,11 @@ void VlasovIsland::Vlasov_2D_Island(
  * */
 
 void VlasovIsland::Vlasov_2D_Island_orig(
-                           CComplex fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1  [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll[NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0  [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1  [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinearTerm                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs_dx[NxGB], 
@@ -1106,7 +1095,7 @@ void VlasovIsland::Vlasov_2D_Island_orig(
     simd_for(int v = NvLlD; v <= NvLuD; v++) {
 
       const CComplex g    = fs[s][m][z][y_k][x][v];
-      const CComplex f0_  = f0[s][m][z][y_k][x][v];
+      const double   f0_  = f0[s][m][z][x][v];
 
       /////////////////////////////////////////////////// Magnetic Island Contribution    /////////////////////////////////////////
       
@@ -1155,8 +1144,7 @@ void VlasovIsland::Vlasov_2D_Island_orig(
        -  ky* (w_n + w_T * (((V[v]*V[v])+ M[m])*kw_T  - sub)) * f0_ * 
     //  (phi_ - (y_k == 1 ? V[v] * MagIs[x] : 0.  )  ) )                  // Source term (Temperature/Density gradient)
           phi_                                                           // Source term (Temperature/Density gradient)
-       -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_)                  // Linear Landau damping
-       +  Coll[s][m][z][y_k][x][v]  ;                                     // Collisional operator
+       -  alpha  * V[v]* kp  * ( g + sigma * phi_ * f0_);                 // Linear Landau damping
      //        -  half_eta_kperp2_phi * f0_)                              // Contributions from gyro-1 (0 if not neq Gyro-1)
          
         //////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1177,8 +1165,8 @@ void VlasovIsland::Vlasov_2D_Island_orig(
 
 
 void VlasovIsland::setupXiAndG(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex Xi                           [NzLB][Nky][NxLB+4][NvLB],
                            CComplex G                            [NzLB][Nky][NxLB  ][NvLB],
@@ -1204,7 +1192,7 @@ void VlasovIsland::setupXiAndG(
                                                             - (useBp ? aeb*M[m]*Fields[Field::Bp][s][m][z][y_k][x] : 0.);
 
     // Island testing    
-    G [z][y_k][x][v] = g[s][m][z][y_k][x][v] + sigma * Fields[Field::phi][s][m][z][y_k][x] * f0[s][m][z][y_k][x][v];
+    G [z][y_k][x][v] = g[s][m][z][y_k][x][v] + sigma * Fields[Field::phi][s][m][z][y_k][x] * f0[s][m][z][x][v];
 
      // substract canonical momentum to get "real" f1 (not used "yet")
      // f1[z][y_k][x][v] = g[s][m][z][y_k][x][v] - (useAp ? saeb * V[v] * f0[s][n][z][y_k][x][v] * Ap[s][m][z][y_k][x] : 0.);
@@ -61,12 +61,11 @@ class VlasovIsland : public VlasovAux {
    *
    **/
    void  Vlasov_2D_Island(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinear                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs[NxGB], 
@@ -76,12 +75,11 @@ class VlasovIsland : public VlasovAux {
                            const double dt, const int rk_step, const double rk[3]);
    
    void  Vlasov_2D_Island_orig(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinear                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs[NxGB], 
@@ -91,12 +89,11 @@ class VlasovIsland : public VlasovAux {
                            const double dt, const int rk_step, const double rk[3]);
 
    void  Vlasov_2D_Island_EM(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex    nonLinearTerm               [Nky][NxLD  ][NvLD],
                            CComplex Xi       [NzLB][Nky][NxLB+4][NvLB],
@@ -108,8 +105,8 @@ class VlasovIsland : public VlasovAux {
                            const double dt, const int rk_step, const double rk[3]);
    
    virtual void setupXiAndG_lin(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
                                  CComplex Xi                     [NzLB][Nky][NxLB+4][NvLB],
                                  CComplex G                      [NzLB][Nky][NxLB  ][NvLB],
@@ -117,8 +114,8 @@ class VlasovIsland : public VlasovAux {
                            const int m, const int s);
 
    virtual void setupXiAndG(
-                           const CComplex g          [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0         [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const PComplex g          [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0         [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
                            const CComplex Fields [Nq][NsLD][NmLD][NzLB][Nky][NxLB+4],
                                  CComplex Xi                     [NzLB][Nky][NxLB+4][NvLB],
                                  CComplex G                      [NzLB][Nky][NxLB  ][NvLB],
@@ -127,24 +124,22 @@ class VlasovIsland : public VlasovAux {
 
 
    void  Vlasov_2D_Island_Equi(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinear                  [Nky][NxLD  ][NvLD],
                            const double X[NxGB+4], const double V[NvGB], const double M[NmGB],
                            const double dt, const int rk_step, const double rk[3]);
    
    void  Vlasov_2D_Island_filter(
-                           CComplex fs       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex fss      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f0 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex f1 [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           CComplex ft       [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const CComplex Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fs       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex fss      [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double   f0 [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const PComplex f1 [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           PComplex ft       [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const CComplex Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            CComplex nonLinear                  [Nky][NxLD  ][NvLD],
                            const double MagIs[NxGB], const double dMagIs[NxGB], 
@@ -164,7 +159,7 @@ class VlasovIsland : public VlasovAux {
    *    Please Document Me !
    *
    **/
-   void solve(std::string equation_tyoe, Fields *fields, CComplex  *fs, CComplex *fss, double dt, int rk_step, const double rk[3]);
+   void solve(std::string equation_tyoe, Fields *fields, PComplex  *fs, PComplex *fss, double dt, int rk_step, const double rk[3]);
  
   protected :
  
@@ -28,14 +28,14 @@ VlasovOptim::VlasovOptim(Grid *_grid, Parallel *_parallel, Setup *_setup, FileIO
    // no need to call : Is done is base constructor -- or ?    Vlasov::initData(fileIO);    
 }
 
-void VlasovOptim::solve(std::string equation_type, Fields *fields, CComplex *_fs, CComplex *_fss,
+void VlasovOptim::solve(std::string equation_type, Fields *fields, PComplex *_fs, PComplex *_fss,
                         double dt, int rk_step, const double rk[3]) 
 {
  
   if((equation_type == "VlasovAux_ES")) {
 
-      Vlasov_2D((A6sz) _fs, (A6sz) _fss, (A6sz) f0, 
-                (A6sz) f, (A6sz) ft, (A6sz) Coll, (A6sz) fields->Field,
+      Vlasov_2D((A6sp) _fs, (A6sp) _fss, (A5rr) f0, 
+                (A6sp) f, (A6sp) ft, (A6sz) fields->Field,
                 (A4sz) nonLinearTerm, X, V, M, dt, rk_step, rk);
   }
 
@@ -45,12 +45,11 @@ void VlasovOptim::solve(std::string equation_type, Fields *fields, CComplex *_fs
                            
 
  void    VlasovOptim::Vlasov_2D(
-                           const cmplx16 fs        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           cmplx16 fss             [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const cmplx16 f0        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const cmplx16 f1        [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           cmplx16 ft              [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
-                           const cmplx16 Coll      [NsLD][NmLD][NzLB][Nky][NxLB  ][NvLB],
+                           const cmplxP  fs        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           cmplxP  fss             [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           const double  f0        [NsLD][NmLB][NzLB]     [NxLB  ][NvLB],
+                           const cmplxP  f1        [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
+                           cmplxP  ft              [NsLD][NmLB][NzLB][Nky][NxLB  ][NvLB],
                            const cmplx16 Fields[Nq][NsLD][NmLD][NzLB][Nky][NxLB+4]      ,
                            cmplx16 nonLinearTerm               [NzLD][Nky][NxLD][NvLD]  ,
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
@@ -127,9 +126,8 @@ void VlasovOptim::solve(std::string equation_type, Fields *fields, CComplex *_fs
        
        // Note, we split here real and imaginary part to enhance vectorization
        const double dg_dt_re = 
-            ky_im* (-(w_n + w_T * (((V[vv]*V[vv])+ M[m])/kw_T  - 3./2.)) * f0 [s][m][z][y_k][xx][vv].re * phi_im )
-             - alpha  * V[vv]* kp  * ( fs[s][m][z][y_k][xx][vv].im + sigma * phi_im * f0 [s][m][z][y_k][xx][vv].re)
-             + Coll[s][m][z][y_k][xx][vv].re;
+            ky_im* (-(w_n + w_T * (((V[vv]*V[vv])+ M[m])/kw_T  - 3./2.)) * f0 [s][m][z][xx][vv] * phi_im )
+             - alpha  * V[vv]* kp  * ( fs[s][m][z][y_k][xx][vv].im + sigma * phi_im * f0 [s][m][z][xx][vv]);
         
         ft [s][m][z][y_k][xx][vv].re = rk[0] * ft[s][m][z][y_k][xx][vv].re + rk[1] * dg_dt_re                                ;
         fss[s][m][z][y_k][xx][vv].re = f1[s][m][z][y_k][xx][vv].re         + (rk[2] * ft[s][m][z][y_k][xx][vv].re + dg_dt_re) * dt;
@@ -143,9 +141,8 @@ void VlasovOptim::solve(std::string equation_type, Fields *fields, CComplex *_fs
                                   * _kw_12_dv;
        
         const  double dg_dt_im = 
-            ky_im* (-(w_n + w_T * (((V[vv]*V[vv])+ M[m])/kw_T  - 3./2.)) * f0 [s][m][z][y_k][xx][vv].re * phi_re )
-             - alpha  * V[vv]* kp  * ( fs[s][m][z][y_k][xx][vv].re + sigma * phi_re * f0 [s][m][z][y_k][xx][vv].re)
-             + Coll[s][m][z][y_k][xx][vv].im;
+            ky_im* (-(w_n + w_T * (((V[vv]*V[vv])+ M[m])/kw_T  - 3./2.)) * f0 [s][m][z][xx][vv] * phi_re )
+             - alpha  * V[vv]* kp  * ( fs[s][m][z][y_k][xx][vv].re + sigma * phi_re * f0 [s][m][z][xx][vv]);
         
         ft [s][m][z][y_k][xx][vv].im = rk[0] * ft[s][m][z][y_k][xx][vv].im + rk[1] * dg_dt_im                                ;
         fss[s][m][z][y_k][xx][vv].im = f1[s][m][z][y_k][xx][vv].im         + (rk[2] * ft[s][m][z][y_k][xx][vv].im + dg_dt_im) * dt;
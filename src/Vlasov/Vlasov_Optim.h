@@ -38,6 +38,14 @@ class VlasovOptim : public Vlasov {
 
   typedef struct{ double re; double im; } cmplx16;
 
+  // phase space storage type (see PComplex)
+#ifdef GKC_PHASE_SINGLE
+  typedef struct{ float  re; float  im; } cmplxP;
+#else
+  typedef cmplx16 cmplxP;
+#endif
+
+  typedef cmplxP (*A6sp)[0][0][0][0][0];
   typedef cmplx16(*A6sz)[0][0][0][0][0];
   typedef cmplx16(*A5sz)[0][0][0][0];
   typedef cmplx16(*A4sz)[0][0][0];
@@ -53,12 +61,11 @@ class VlasovOptim : public Vlasov {
    *
    **/
    void    Vlasov_2D(
-                           const cmplx16 fs       [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
-                           cmplx16 fss      [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
-                           const cmplx16 f0 [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
-                           const cmplx16 f1 [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
-                           cmplx16 ft       [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
-                           const cmplx16 Coll      [NsLD][NmLD][NzLB][NkyLD][NxLB  ][NvLB],
+                           const cmplxP  fs       [NsLD][NmLB][NzLB][NkyLD][NxLB  ][NvLB],
+                           cmplxP  fss      [NsLD][NmLB][NzLB][NkyLD][NxLB  ][NvLB],
+                           const double  f0 [NsLD][NmLB][NzLB]       [NxLB  ][NvLB],
+                           const cmplxP  f1 [NsLD][NmLB][NzLB][NkyLD][NxLB  ][NvLB],
+                           cmplxP  ft       [NsLD][NmLB][NzLB][NkyLD][NxLB  ][NvLB],
                            const cmplx16 Field[Nq][NsLD][NmLD][NzLB][NkyLD][NxLB+4],
                            cmplx16 nonLinear[NzLD][NkyLD][NxLD][NvLD],
                            const double X[NxGB], const double V[NvGB], const double M[NmGB],
@@ -76,7 +83,7 @@ class VlasovOptim : public Vlasov {
    *    Please Document Me !
    *
    **/
-   void solve(std::string equation_tyoe, Fields *fields, CComplex *fs, CComplex *fss, 
+   void solve(std::string equation_tyoe, Fields *fields, PComplex *fs, PComplex *fss, 
               double dt, int rk_step, const double rk[3]);
  
   
@@ -0,0 +1,233 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: AsyncIO.h
+ *
+ *    Description: Asynchronous (background thread) output for HDF-5
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef ASYNC_IO_H_
+#define ASYNC_IO_H_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <cstring>
+
+/**
+*
+*  @brief Performs HDF-5 writes on a background thread
+*
+*  Writing e.g. the phase-space function stalls the time integration, as
+*  all (OpenMP) threads wait for the master thread. If enabled, FileAttr::write,
+*  TableAttr::append and FileIO::flush copy (snapshot) their data into a staging
+*  buffer and queue the HDF-5 operation, which is performed by a dedicated I/O
+*  thread while time stepping continues.
+*
+*  HDF-5 is in general not thread-safe (especially parallel HDF-5), thus while
+*  the I/O thread is running *all* HDF-5 calls have to go through the queue.
+*  It is therefore only started for the main time integration loop (where
+*  output is done by FileAttr/TableAttr only). All processes queue their
+*  operations in the same order, thus collective operations (e.g. H5Dset_extent)
+*  stay consistent. For MPI-IO, MPI_THREAD_MULTIPLE is required.
+*
+*  Staging buffers are reused, and the total size of queued snapshots is
+*  limited (a write blocks until older snapshots are written), so e.g. two
+*  snapshots of the phase space fit in a buffer of twice its size (double-buffering).
+*
+**/
+class AsyncIO
+{
+  typedef std::shared_ptr<std::vector<char> > Buffer;
+
+  /// Queued I/O operation
+  struct Job {
+    std::function<void ()> func; ///< HDF-5 operation
+    Buffer                 buf;  ///< staging buffer (returned to pool after write)
+    size_t                 bytes;///< size of snapshot
+  };
+
+  std::thread             thread;     ///< background I/O thread
+  std::mutex              mutex;      ///< protects queue, pool and counters
+  std::condition_variable cv_queue,   ///< signals new job (or stop) to I/O thread
+                          cv_done;    ///< signals finished job to submitting thread
+
+  std::deque<Job>         jobs;       ///< queued operations
+  std::vector<Buffer>     pool;       ///< unused staging buffers
+
+  size_t bytesQueued,                 ///< size of queued snapshots
+         maxBytes;                    ///< maximum size of queued snapshots
+
+  bool   running,                     ///< true if I/O thread is running
+         busy,                        ///< true if I/O thread is executing a job
+         stopping;                    ///< true if I/O thread should exit
+
+  AsyncIO() : bytesQueued(0), maxBytes(0), running(false), busy(false), stopping(false) {};
+
+ ~AsyncIO() { stop(); };
+
+  static AsyncIO& get()
+  {
+    static AsyncIO io;
+    return io;
+  };
+
+  /**
+  *   @brief main loop of I/O thread
+  *
+  **/
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for(;;) {
+
+      cv_queue.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+      if(jobs.empty()) break; // stopping, and all jobs are done
+
+      Job job = jobs.front(); jobs.pop_front();
+      busy = true;
+
+      lock.unlock();
+      job.func();
+      lock.lock();
+
+      if(job.buf) pool.push_back(job.buf);
+      bytesQueued -= job.bytes;
+      busy         = false;
+
+      cv_done.notify_all();
+    }
+  };
+
+  /**
+  *   @brief take staging buffer of at least bytes from pool
+  *
+  **/
+  Buffer getBuffer(size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for(auto it = pool.begin(); it != pool.end(); it++) {
+
+      if((*it)->size() >= bytes) { Buffer buf = *it; pool.erase(it); return buf; }
+    }
+
+    return Buffer(new std::vector<char>(bytes));
+  };
+
+ public:
+
+  /**
+  *   @brief start I/O thread
+  *
+  *   @param maxBytes maximum size of queued snapshots in bytes
+  *
+  **/
+  static void start(size_t maxBytes)
+  {
+    AsyncIO &io = get();
+    if(io.running) return;
+
+    io.maxBytes = maxBytes;
+    io.stopping = false;
+    io.running  = true;
+    io.thread   = std::thread(&AsyncIO::run, &io);
+  };
+
+  /**
+  *   @brief finish all queued operations and stop I/O thread
+  *
+  **/
+  static void stop()
+  {
+    AsyncIO &io = get();
+    if(!io.running) return;
+
+    {
+      std::lock_guard<std::mutex> lock(io.mutex);
+      io.stopping = true;
+    }
+    io.cv_queue.notify_one();
+    io.thread.join();
+
+    io.running = false;
+    io.pool.clear();
+  };
+
+  /**
+  *   @brief returns true if output is written asynchronously
+  *
+  **/
+  static bool isEnabled() { return get().running; };
+
+  /**
+  *   @brief wait until all queued operations are finished
+  *
+  **/
+  static void wait()
+  {
+    AsyncIO &io = get();
+    if(!io.running) return;
+
+    std::unique_lock<std::mutex> lock(io.mutex);
+    io.cv_done.wait(lock, [&io] { return io.jobs.empty() && !io.busy; });
+  };
+
+  /**
+  *   @brief Copy data to staging buffer and queue operation
+  *
+  *   @param data  pointer to data (may be overwritten after return)
+  *   @param bytes size of data
+  *   @param func  operation performed on the snapshot of data
+  *
+  **/
+  static void write(const void *data, size_t bytes, std::function<void (const void *)> func)
+  {
+    AsyncIO &io = get();
+
+    if(!io.running) { func(data); return; }
+
+    // limit size of queued snapshots (always allow at least one)
+    {
+      std::unique_lock<std::mutex> lock(io.mutex);
+      io.cv_done.wait(lock, [&] { return (io.bytesQueued == 0) || (io.bytesQueued + bytes <= io.maxBytes); });
+    }
+
+    Buffer buf = io.getBuffer(bytes > 0 ? bytes : 1);
+    if(bytes > 0) std::memcpy(buf->data(), data, bytes);
+
+    const char *snapshot = buf->data();
+    submit([=] { func(snapshot); }, buf, bytes);
+  };
+
+  /**
+  *   @brief Queue operation which does not require a snapshot (e.g. flush)
+  *
+  **/
+  static void submit(std::function<void ()> func, Buffer buf=Buffer(), size_t bytes=0)
+  {
+    AsyncIO &io = get();
+
+    if(!io.running) { func(); return; }
+
+    {
+      std::lock_guard<std::mutex> lock(io.mutex);
+      io.jobs.push_back({ func, buf, bytes });
+      io.bytesQueued += bytes;
+    }
+    io.cv_queue.notify_one();
+  };
+};
+
+#endif // ASYNC_IO_H_
@@ -17,6 +17,9 @@
 #include "hdf5.h"
 #include "hdf5_hl.h"
 
+#include "SHDF5/AsyncIO.h"
+#include "SHDF5/QuantizeFilter.h"
+
 /**
 *  
 *  @brief Class for simplifying HDF-5 dataset creation
@@ -54,8 +57,82 @@ class FileAttr
 
   bool do_write;                     ///< Does process write to data
 
+  size_t bytes;                      ///< Size of memory space in bytes (for snapshots)
+
+  /**
+  *    @brief Write data of extent dim at off to HDF-5 file
+  *
+  **/
+  void writeExtent(const hsize_t _dim[], const hsize_t _off[], const void *data)
+  {
+    check( H5Dset_extent (dataset_hdf, _dim) , DMESG("Extending Dataset")); 
+
+    hid_t dspace = H5Dget_space (dataset_hdf);
+
+    // select hyperslab (ignore if not part of reading family) & write 
+    check( H5Sselect_hyperslab (dspace, H5S_SELECT_SET, _off, stride1, cdim, NULL), DMESG("HDF-5 Error"));
+    if(do_write == false) H5Sselect_none(dspace); 
+    check( H5Dwrite(dataset_hdf, typeId_hdf, memory_space_hdf, dspace, property_hdf, data)  , DMESG("HDF-5 Error"));
+    H5Sclose(dspace);
+  };
+
+  /**
+  *    @brief Add compression filters to dataset creation property
+  *
+  *    For floating point types (also compounds of these, e.g. complex),
+  *    values are quantised if a tolerance is set. Followed by shuffle 
+  *    (if lossless) and deflate.
+  *
+  **/
+  void setFilters(hid_t dcpl)
+  {
+    const Compression &comp = compression();
+
+    const H5T_class_t typeClass = H5Tget_class(typeId_hdf);
+
+    // size of floating point value (first member of compound)
+    size_t floatSize = 0;
+    if(typeClass == H5T_FLOAT) floatSize = H5Tget_size(typeId_hdf);
+    if(typeClass == H5T_COMPOUND) {
+      hid_t member = H5Tget_member_type(typeId_hdf, 0);
+      if(H5Tget_class(member) == H5T_FLOAT) floatSize = H5Tget_size(member);
+      H5Tclose(member);
+    }
+
+    const bool lossy = (comp.tolerance > 0.) && (floatSize > 0);
+
+    if(lossy) {
+
+      unsigned int cd_values[3];
+      QuantizeFilter::setParameters(cd_values, floatSize, comp.tolerance);
+      check(H5Pset_filter(dcpl, QuantizeFilter::ID, H5Z_FLAG_OPTIONAL, 3, cd_values), DMESG("H5Pset_filter"));
+    }
+    else if(comp.level > 0) check(H5Pset_shuffle(dcpl), DMESG("H5Pset_shuffle"));
+
+    if(comp.level > 0) check(H5Pset_deflate(dcpl, comp.level), DMESG("H5Pset_deflate"));
+  };
+
  public: 
 
+  /**
+  *    @brief Compression settings for datasets created with compress=true
+  *
+  **/
+  struct Compression {
+    int    level;     ///< deflate level (0 : no compression, 1-9)
+    double tolerance; ///< absolute error bound for lossy quantisation (0 : lossless)
+  };
+
+  /**
+  *    @brief global compression settings (set by FileIO)
+  *
+  **/
+  static Compression& compression() 
+  {
+    static Compression comp = { 0, 0. };
+    return comp;
+  };
+
   /**
   *
   *
@@ -65,6 +142,8 @@ class FileAttr
   *    cdoff - Chunk Data off
   *    dsdim - Dataset dimensions
   *    dmdim - Dataset maximum dimension
+  *
+  *    compress - use compression filters (see Compression)
   *   
   **/
   FileAttr(std::string _name, hid_t group, hid_t file_id, int _ndim, 
@@ -73,7 +152,8 @@ class FileAttr
            hsize_t cBdim[], hsize_t  _off[],   
            bool _write, 
            hid_t _typeId_hdf = H5T_NATIVE_DOUBLE, 
-           bool createFile=true) 
+           bool createFile=true,
+           bool compress=false) 
   : ndim(_ndim), do_write(_write), typeId_hdf(_typeId_hdf), name(_name)
   {
     copy(_dim, dim); copy(_mdim, mdim); copy(_cdim, cdim); copy(_off, off);
@@ -88,9 +168,12 @@ class FileAttr
        
     if(do_write == false) H5Sselect_none(memory_space_hdf);
 
+    // required to snapshot data for asynchronous writes (no HDF-5 calls allowed then)
+    bytes = do_write ? H5Sget_simple_extent_npoints(memory_space_hdf) * H5Tget_size(typeId_hdf) : 0;
+
     property_hdf = H5P_DEFAULT;
 
-#ifdef USE_MPI // if domain decomposition is enables
+#ifdef GKC_PARALLEL_MPI // if domain decomposition is enabled, all processes take part in the write
     property_hdf = H5Pcreate(H5P_DATASET_XFER);
     H5Pset_dxpl_mpio(property_hdf, H5FD_MPIO_COLLECTIVE);
 #endif
@@ -104,6 +187,8 @@ class FileAttr
       hid_t dspace = check ( H5Screate_simple(ndim, dim, mdim) , DMESG("HDF-5 Error"));
       hid_t dcpl   = H5Pcreate (H5P_DATASET_CREATE);
       H5Pset_chunk(dcpl, ndim, cdim);
+      
+      if(compress) setFilters(dcpl);
 
       // usually the dataset is access once, tell HDF-5 thus to not to use reduce buffers 
       hid_t dapl   = H5P_DEFAULT;
@@ -122,7 +207,9 @@ class FileAttr
   /**
   *    @brief Write Data to HDF-5 file
   *
-  *    Write data, by first extending last dimensions.
+  *    Write data, by first extending last dimensions. If asynchronous
+  *    output is enabled, data is copied and written by the I/O thread
+  *    (see AsyncIO), thus data may be modified after return.
   *
   **/
   template<typename T> void write(T data, int increase=+1) 
@@ -131,15 +218,37 @@ class FileAttr
     dim[ndim-1] += increase;
     off[ndim-1] += increase;
       
-    check( H5Dset_extent (dataset_hdf, dim) , DMESG("Extending Dataset")); 
+    if(AsyncIO::isEnabled()) {
 
-    hid_t dspace = H5Dget_space (dataset_hdf);
+      // extent is captured by value, as further writes may be queued 
+      hsize_t _dim[7], _off[7];
+      copy(dim, _dim); copy(off, _off);
 
-    // select hyperslab (ignore if not part of reading family) & write 
-    check( H5Sselect_hyperslab (dspace, H5S_SELECT_SET, off, stride1, cdim, NULL), DMESG("HDF-5 Error"));
-    if(do_write == false) H5Sselect_none(dspace); 
-    check( H5Dwrite(dataset_hdf, typeId_hdf, memory_space_hdf, dspace, property_hdf, data)  , DMESG("HDF-5 Error"));
-    H5Sclose(dspace);
+      AsyncIO::write((const void *) data, bytes, [=](const void *snapshot) { writeExtent(_dim, _off, snapshot); });
+    } 
+    else writeExtent(dim, off, (const void *) data);
+  };
+   
+  /**
+  *    @brief Write Data at index of last dimension
+  *
+  *    Overwrites data at index (e.g. rotating checkpoint slots), the
+  *    dataset is only extended if required.
+  *
+  **/
+  template<typename T> void writeAt(T data, hsize_t index) 
+  {
+    if(index >= dim[ndim-1]) dim[ndim-1] = index + 1;
+    off[ndim-1] = index;
+      
+    if(AsyncIO::isEnabled()) {
+
+      hsize_t _dim[7], _off[7];
+      copy(dim, _dim); copy(off, _off);
+
+      AsyncIO::write((const void *) data, bytes, [=](const void *snapshot) { writeExtent(_dim, _off, snapshot); });
+    } 
+    else writeExtent(dim, off, (const void *) data);
   };
    
   /**
@@ -151,17 +260,44 @@ class FileAttr
   **/
   template<typename T> void read(T data, int time_off=-1) 
   {
+    AsyncIO::wait();
+
     hid_t dspace = H5Dget_space (dataset_hdf);
         
     // get dimensions of stored array
-    hsize_t off[7];
-    H5Sget_simple_extent_dims (dspace, off, NULL);
+    hsize_t _dim[7];
+    H5Sget_simple_extent_dims (dspace, _dim, NULL);
 
-    // shift last dimensions
-    hsize_t off_2[7] = { 0, 0, 0, 0, 0, 0, off[6]+time_off };
+    // offset of local domain (independent of decomposition used for writing), 
+    // shifted in last dimension
+    hsize_t _off[7];
+    copy(off, _off);
+    _off[ndim-1] = _dim[ndim-1] + time_off;
     
     // select hyperslab (ignore if not part of reading family) & read 
-    check(H5Sselect_hyperslab (dspace, H5S_SELECT_SET, off_2, stride1, cdim, NULL), DMESG("HDF-5 Error"));
+    check(H5Sselect_hyperslab (dspace, H5S_SELECT_SET, _off, stride1, cdim, NULL), DMESG("HDF-5 Error"));
+    if(do_write == false) H5Sselect_none(dspace); 
+    check(H5Dread(dataset_hdf, typeId_hdf, memory_space_hdf, dspace, property_hdf, data), DMESG("HDF-5 Error"));
+
+    H5Sclose(dspace);
+  }
+
+  /**
+  *    @brief Reads data at index of last dimension
+  *
+  **/
+  template<typename T> void readAt(T data, hsize_t index) 
+  {
+    AsyncIO::wait();
+
+    hid_t dspace = H5Dget_space (dataset_hdf);
+        
+    // offset of local domain
+    hsize_t _off[7];
+    copy(off, _off);
+    _off[ndim-1] = index;
+    
+    check(H5Sselect_hyperslab (dspace, H5S_SELECT_SET, _off, stride1, cdim, NULL), DMESG("HDF-5 Error"));
     if(do_write == false) H5Sselect_none(dspace); 
     check(H5Dread(dataset_hdf, typeId_hdf, memory_space_hdf, dspace, property_hdf, data), DMESG("HDF-5 Error"));
 
@@ -170,6 +306,9 @@ class FileAttr
 
  ~FileAttr() 
   {
+    // queued writes may still access dataset
+    AsyncIO::wait();
+
     // close dataset, -space and -property
     check( H5Dclose(dataset_hdf)     ,  DMESG("HDF-5 Error"));
     check( H5Pclose(property_hdf)    ,  DMESG("HDF-5 Error"));
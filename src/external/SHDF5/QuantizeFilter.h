@@ -0,0 +1,212 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename: QuantizeFilter.h
+ *
+ *    Description: Error-bounded (lossy) quantisation filter for HDF-5
+ *
+ *         Author: Paul P. Hilscher (2013-),
+ *
+ *        License: GPLv3+
+ * =====================================================================================
+ */
+
+#ifndef QUANTIZE_FILTER_H_
+#define QUANTIZE_FILTER_H_
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#include "hdf5.h"
+
+/**
+*
+*  @brief Lossy compression filter with absolute error bound
+*
+*  Floating point values x (float or double, also as members of compound
+*  types as complex numbers) are quantised to integers
+*
+*  \f[  q = \textrm{round}\left( \frac{x}{2 \epsilon} \right) \f]
+*
+*  thus the reconstruction \f$ 2 \epsilon q \f$ has an absolute error smaller
+*  than \f$ \epsilon \f$. The integers are stored with 4 bytes (if the range
+*  allows for it, otherwise 8 bytes) and byte-shuffled, such that the
+*  following deflate filter compresses the (mostly zero) high bytes
+*  efficiently.
+*
+*  The filter parameters (cd_values) are
+*
+*    [0] size of floating point value (4 or 8 bytes)
+*    [1] upper 32 bits of tolerance \f$ \epsilon \f$ (as IEEE double)
+*    [2] lower 32 bits of tolerance
+*
+*  The filter is optional, thus chunks which cannot be quantised (e.g.
+*  Inf/NaN values) are stored unfiltered.
+*
+*  Note : the filter has to be registered (QuantizeFilter::registerFilter) also
+*         for reading the data (e.g. in Python through a plugin).
+*
+**/
+namespace QuantizeFilter {
+
+  const H5Z_filter_t ID = 400; ///< Filter id (range 256-511 is reserved for private use)
+
+  /// Header of filtered chunk
+  struct Header {
+    uint64_t num;   ///< number of values
+    uint32_t width; ///< bytes per quantised value (4 or 8)
+    uint32_t size;  ///< bytes per floating point value (4 or 8)
+  };
+
+  /**
+  *   @brief encode tolerance into filter parameters
+  *
+  **/
+  inline void setParameters(unsigned int cd_values[3], const size_t size, const double tolerance)
+  {
+    uint64_t bits; std::memcpy(&bits, &tolerance, sizeof(double));
+
+    cd_values[0] = size;
+    cd_values[1] = bits >> 32;
+    cd_values[2] = bits & 0xffffffff;
+  };
+
+  /**
+  *   @brief byte-shuffle (or unshuffle) num values of width bytes
+  *
+  **/
+  inline void shuffle(const char *in, char *out, const size_t num, const size_t width, const bool forward)
+  {
+    for(size_t n = 0; n < num  ; n++) {
+    for(size_t b = 0; b < width; b++) {
+
+      if(forward) out[b * num + n] = in[n * width + b];
+      else        out[n * width + b] = in[b * num + n];
+    } }
+  };
+
+  /**
+  *   @brief HDF-5 filter function (H5Z_func_t)
+  *
+  **/
+  inline size_t filter(unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[],
+                       size_t nbytes, size_t *buf_size, void **buf)
+  {
+    if(cd_nelmts < 3) return 0;
+
+    const size_t size = cd_values[0];
+
+    double tolerance;
+    const uint64_t bits = (uint64_t(cd_values[1]) << 32) | cd_values[2];
+    std::memcpy(&tolerance, &bits, sizeof(double));
+
+    const double step = 2. * tolerance;
+
+    if(!(flags & H5Z_FLAG_REVERSE)) { ////////////////////// Compress //////////////////////
+
+      if(((size != 4) && (size != 8)) || (nbytes % size) || !(step > 0.)) return 0;
+
+      const size_t num = nbytes / size;
+
+      int64_t *q = (int64_t *) std::malloc(num * sizeof(int64_t));
+      if(q == nullptr) return 0;
+
+      // quantise and get required width
+      int64_t q_max = 0;
+
+      for(size_t n = 0; n < num; n++) {
+
+        const double x = (size == 4) ? ((float *) *buf)[n] : ((double *) *buf)[n];
+        const double y = x / step;
+
+        // values cannot be quantised (store chunk unfiltered)
+        if(!std::isfinite(y) || (std::abs(y) > 4.e18)) { std::free(q); return 0; }
+
+        q[n]  = (int64_t) std::llround(y);
+        q_max = std::max(q_max, std::abs(q[n]));
+      }
+
+      const uint32_t width = (q_max < 2147483647) ? 4 : 8;
+
+      const size_t outbytes = sizeof(Header) + num * width;
+      char *out = (char *) std::malloc(outbytes);
+      if(out == nullptr) { std::free(q); return 0; }
+
+      Header header = { num, width, (uint32_t) size };
+      std::memcpy(out, &header, sizeof(Header));
+
+      // narrow to 32 bits (in place), then shuffle bytes
+      if(width == 4) for(size_t n = 0; n < num; n++) ((int32_t *) q)[n] = (int32_t) q[n];
+
+      shuffle((const char *) q, out + sizeof(Header), num, width, true);
+
+      std::free(q);
+      std::free(*buf);
+
+      *buf      = out;
+      *buf_size = outbytes;
+
+      return outbytes;
+
+    } else { ////////////////////////////////////////////// Decompress ////////////////////
+
+      if(nbytes < sizeof(Header)) return 0;
+
+      Header header;
+      std::memcpy(&header, *buf, sizeof(Header));
+
+      const size_t num = header.num, width = header.width;
+
+      if(nbytes < sizeof(Header) + num * width) return 0;
+
+      char *q   = (char *) std::malloc(num * width);
+      char *out = (char *) std::malloc(num * header.size);
+      if((q == nullptr) || (out == nullptr)) { std::free(q); std::free(out); return 0; }
+
+      shuffle((const char *) *buf + sizeof(Header), q, num, width, false);
+
+      for(size_t n = 0; n < num; n++) {
+
+        const double x = step * ((width == 4) ? ((int32_t *) q)[n] : ((int64_t *) q)[n]);
+
+        if(header.size == 4) ((float  *) out)[n] = x;
+        else                 ((double *) out)[n] = x;
+      }
+
+      std::free(q);
+      std::free(*buf);
+
+      *buf      = out;
+      *buf_size = num * header.size;
+
+      return num * header.size;
+    }
+  };
+
+  /**
+  *   @brief register filter with HDF-5 library (once)
+  *
+  **/
+  inline herr_t registerFilter()
+  {
+    if(H5Zfilter_avail(ID) > 0) return 0;
+
+    const H5Z_class2_t filterClass = {
+      H5Z_CLASS_T_VERS,            // version
+      ID,                          // filter id
+      1, 1,                        // encoder/decoder present
+      "GKC quantise (error-bounded)",
+      NULL,                        // can_apply
+      NULL,                        // set_local
+      (H5Z_func_t) filter
+    };
+
+    return H5Zregister(&filterClass);
+  };
+
+} // namespace QuantizeFilter
+
+#endif // QUANTIZE_FILTER_H_
@@ -17,6 +17,12 @@
 #include "hdf5.h"
 #include "hdf5_hl.h"
 
+#include "SHDF5/AsyncIO.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
 /**
 *   @brief Wrapper for HDF-5 tables
 *
@@ -24,6 +30,12 @@
 *   It basically stores the array structures as they are needed
 *   in both, H5TBmake_table  and H5TBappend_records.
 *
+*   Appended records are buffered and written in batches of bufferRows()
+*   records, as each H5TBappend_records extends the dataset (which is
+*   expensive on parallel file systems). Buffered records of all tables
+*   are written by flushAll (called by FileIO::flush) or on destruction.
+*   The number of appended records has to be identical on all processes
+*   (collective operation), thus no wall-clock based threshold is used.
 *
 *   @todo How to use ... docu
 *
@@ -40,15 +52,44 @@ class TableAttr
   template<typename T> void copy(T inValues[], T copiedValues[]) {for(int n=0;n<numCol; n++) copiedValues[n] = inValues[n];};
   std::string name;
 
+  size_t            recordSize;  ///< size of record in bytes
+  int               numBuffered; ///< number of buffered records
+  std::vector<char> buffer;      ///< buffered records
+
+  /// all tables in order of creation (for flushAll, which is collective thus
+  /// the order has to be identical on all processes)
+  static std::vector<TableAttr *>& tables()
+  {
+    static std::vector<TableAttr *> t;
+    return t;
+  };
+
  public: 
 
+  /**
+  *   @brief maximum number of buffered records per table (1 writes immediately)
+  *
+  **/
+  static int& bufferRows()
+  {
+    static int rows = 64;
+    return rows;
+  };
+
+  /**
+  *   @brief write buffered records of all tables
+  *
+  **/
+  static void flushAll() { for(auto table : tables()) table->flush(); };
+
+
   /**
   *   @brief please document me ...
   *
   **/
   template<typename T>
   TableAttr(hid_t _nodeID, std::string  _name, int _numCol, const char *field_names[], 
-            size_t _offsets[], hid_t _types[], size_t _sizes[], T *table) : numCol(_numCol), nodeID(_nodeID) 
+            size_t _offsets[], hid_t _types[], size_t _sizes[], T *table) : numCol(_numCol), nodeID(_nodeID), recordSize(sizeof(T)), numBuffered(0)
   {
     
     check((numCol > 32) ? -1 : 1, DMESG("TableAttr : number of fields is limited to 32. Increase TABLE_LIM_MAX"));
@@ -62,24 +103,58 @@ class TableAttr
            
     check(H5TBmake_table(name.c_str(), nodeID, name.c_str(), (hsize_t) numCol, (hsize_t) 0, sizeof(T), (const char**) field_names,
                          offsets, types, 100, NULL, 0, table ), DMESG("H5Tmake_table : scalarValue"));
+
+    tables().push_back(this);
   }
 
   /**
-  *   @brief please document me ...
+  *   @brief Append n records to table
+  *
+  *   Records are copied to the buffer, which is written if
+  *   it holds at least bufferRows() records.
   *
   **/
   template<class T> void append(T *table, int n=1) 
   {
-    check(H5TBappend_records (nodeID, name.c_str(), n, sizeof(T), offsets, sizes, table), DMESG("Append Table"));
+    check((sizeof(T) != recordSize) ? -1 : 1, DMESG("TableAttr : record size does not match table"));
+
+    buffer.resize((numBuffered + n) * recordSize);
+    std::memcpy(&buffer[numBuffered * recordSize], (const void *) table, n * recordSize);
+    numBuffered += n;
+
+    if(numBuffered >= bufferRows()) flush();
+  };
+
+  /**
+  *   @brief Write buffered records
+  *
+  **/
+  void flush()
+  {
+    if(numBuffered == 0) return;
+
+    const int    n = numBuffered;
+    const size_t s = recordSize;
+
+    // records are copied if written asynchronously (see AsyncIO)
+    AsyncIO::write((const void *) buffer.data(), n * s, [=](const void *records) {
+      check(H5TBappend_records (nodeID, name.c_str(), n, s, offsets, sizes, records), DMESG("Append Table"));
+    });
+
+    numBuffered = 0;
   };
 
 
   /**
-  *   @brief please document me ...
+  *   @brief writes buffered records
   *
   **/
  ~TableAttr() 
  {
+   flush();
+   tables().erase(std::remove(tables().begin(), tables().end(), this), tables().end());
+
+   AsyncIO::wait();
 //       H5Gclose(node); 
  };
 };
@@ -43,6 +43,15 @@
 #include <iostream>
 #include <vector>
 #include <stack>
+#include <utility>
+#include <string>
+#include <map>
+
+#include <sys/mman.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace nct { /// use better nct for numerical computing toolkit
 
@@ -93,8 +102,66 @@ enum alloc_flags  {
              SET_ZERO=2  ,    ///< do not set to Zero 
              DEALLOC=4   ,    ///< do not deallocate 
              USE_DEFAULT = 7, ///< use default values 
+             FIRST_TOUCH = 8, ///< set to zero in parallel (NUMA first-touch placement)
+             HUGE_PAGES  =16, ///< align large arrays to 2 MB and advise transparent huge pages
+             USE_NUMA    =31, ///< default values including FIRST_TOUCH and HUGE_PAGES
            };
 
+/**
+*    @brief single entry of the memory registry
+*
+**/
+struct alloc_record {
+
+  std::string owner,   ///< Module which owns the array (e.g. Vlasov)
+              purpose; ///< Description of array (e.g. phase space)
+  size_t      bytes;   ///< Size of allocation
+
+};
+
+/**
+*    @brief Registry of all allocations
+*
+*    Records owner, purpose and size of every array allocated with
+*    nct::allocate, and of external allocations (e.g. FFTW buffers)
+*    which are registered manually using allocate::record. The 
+*    owner is the module currently set by allocate::setOwner.
+*
+*    Also accumulates how much memory was placed by first-touch and 
+*    huge pages.
+*
+*    @note not thread-safe, allocate outside of parallel regions 
+*          or from a single thread only
+*
+**/
+struct alloc_registry {
+
+  std::string owner = "Unknown";  ///< Current owner of new allocations
+
+  size_t bytesCurrent   = 0, ///< Currently allocated memory
+         bytesPeak      = 0, ///< Peak of allocated memory
+         bytesFirstTouch= 0, ///< Memory set to zero by all threads
+         bytesHugePages = 0; ///< Memory advised to use transparent huge pages
+
+  std::map<std::string, size_t> bytesOwner; ///< Currently allocated memory per owner
+  std::vector<alloc_record>     records   ; ///< List of all allocations
+
+  void add(const std::string &_owner, const std::string &purpose, size_t bytes)
+  {
+    records.push_back({ _owner, purpose, bytes });
+    bytesOwner[_owner] += bytes;
+    bytesCurrent       += bytes;
+    if(bytesCurrent > bytesPeak) bytesPeak = bytesCurrent;
+  };
+
+  void remove(const std::string &_owner, size_t bytes)
+  {
+    bytesOwner[_owner] -= bytes;
+    bytesCurrent       -= bytes;
+  };
+
+};
+
 
 /**
 *    @brief Allocating multi-dimensional arrays based on ranges
@@ -127,8 +194,46 @@ class allocate
 
   int flags; ///< Deallocate all arrays after usage
  
-  
-  std::stack<void *> ptr_stack; ///< stack holding array pointers
+  int NumOuter, ///< Number of outer (serial) elements for first-touch 
+      NumPar  , ///< Number of elements distributed over threads for first-touch
+      NumInner; ///< Number of continuous elements for first-touch
+
+  std::string name; ///< Purpose of arrays, used for memory registry
+
+  /// Allocated array
+  struct alloc_ptr {
+    void        *ptr  ; ///< array pointer
+    bool         isMM ; ///< set if allocated with _mm_malloc
+    size_t       bytes; ///< size of allocation 
+    std::string  owner; ///< owner as recorded in registry
+  };
+
+  std::stack<alloc_ptr> ptr_stack; ///< stack holding array pointers
+
+  /**
+  *    @brief set the decomposition used for first-touch
+  *
+  *    Kernels loop serially over the outer dimensions, distribute
+  *    the next two dimensions (e.g. ky, x) with a static schedule
+  *    over the threads and loop continuously over the last dimension
+  *    (e.g. v). Zeroing in the same order places the pages on the 
+  *    NUMA node of the thread which later accesses it.
+  *
+  *    The split is tuned for the phase space [s][m][z][ky][x][v], 
+  *    which is zeroed with outer (s,m,z), parallel (ky,x) and inner v.
+  *    This matches the main kernel (VlasovCilk::Vlasov_EM, omp for collapse(2) over 
+  *    (ky,x) for each s,m,z) up to the ghost cells in x and the Nyquist
+  *    mode, which the kernel does not iterate, thus thread blocks are
+  *    shifted by a few (ky,x) rows only. The Maxwellian [s][m][z][x][v]
+  *    is split over (z,x), which does not match this kernel (but it is 
+  *    smaller by a factor Nky). Kernels with a different split, e.g. 
+  *    setupXiAndG over (z,ky), operate on arrays without first-touch.
+  *
+  **/
+  void setFirstTouch(int outer, int par, int inner)
+  {
+    NumOuter = outer; NumPar = par; NumInner = inner;
+  };
 
  public:
 
@@ -139,6 +244,46 @@ class allocate
   {
     Num = 0;
     Off = 0;
+    setFirstTouch(1, 0, 1);
+  };
+
+  /**
+  *    @brief global memory registry
+  *
+  **/
+  static alloc_registry& registry() 
+  {
+    static alloc_registry reg;
+    return reg;
+  };
+
+  /**
+  *    @brief set owner of all following allocations
+  *
+  *    @param owner name of module (e.g. Vlasov)
+  *
+  **/
+  static void setOwner(const std::string &owner) { registry().owner = owner; };
+
+  /**
+  *    @brief register memory not allocated by nct::allocate (e.g. FFTW buffers)
+  *
+  **/
+  static void record(const std::string &purpose, size_t bytes) 
+  { 
+    registry().add(registry().owner, purpose, bytes); 
+  };
+
+  /**
+  *    @brief set purpose of arrays for memory registry
+  *
+  *    e.g. nct::allocate(R0, R1).purpose("Fields")(&A);
+  *
+  **/
+  allocate&& purpose(const std::string &_name)
+  {
+    name = _name;
+    return std::move(*this);
   };
 
   /**
@@ -155,6 +300,9 @@ class allocate
     flags     = alloc.flags;
     Num       = alloc.Num;
     Off       = alloc.Off;
+    name      = alloc.name;
+    
+    setFirstTouch(alloc.NumOuter, alloc.NumPar, alloc.NumInner);
 
     // probably move can be used, but 
     ptr_stack = alloc.ptr_stack;
@@ -204,6 +352,8 @@ class allocate
        
     // calculate offset to p[0]
     Off = R0.Off(); 
+    
+    setFirstTouch(1, R0.Num(), 1);
      
   };
 
@@ -226,6 +376,8 @@ class allocate
     // calculate offset to p[0][0]
     Off = R0.Off() * (R1.Num()) 
         + R1.Off() ;
+    
+    setFirstTouch(1, R0.Num(), R1.Num());
   };
    
    
@@ -255,6 +407,7 @@ class allocate
         + R1.Off() * (R2.Num()) 
         + R2.Off() ;
 
+    setFirstTouch(1, R0.Num() * R1.Num(), R2.Num());
   };
 
   /**
@@ -280,6 +433,7 @@ class allocate
         + R2.Off() * (R3.Num()) 
         + R3.Off() ;
 
+       setFirstTouch(R0.Num(), R1.Num() * R2.Num(), R3.Num());
    };
    
    /**
@@ -313,6 +467,7 @@ class allocate
         + R3.Off() * (R4.Num()) 
         + R4.Off() ;
 
+       setFirstTouch(R0.Num() * R1.Num(), R2.Num() * R3.Num(), R4.Num());
    };
 
    /**
@@ -345,6 +500,7 @@ class allocate
         + R4.Off() * (R5.Num()) 
         + R5.Off() ;
 
+       setFirstTouch(R0.Num() * R1.Num() * R2.Num(), R3.Num() * R4.Num(), R5.Num());
    };
 
    
@@ -364,10 +520,12 @@ class allocate
         while (!ptr_stack.empty()) {
       
           // release top element
-          void *ptr = ptr_stack.top();
+          const alloc_ptr &p = ptr_stack.top();
          
-          if(flags & MA) _mm_free(ptr);
-          else               free(ptr);
+          if(p.isMM) _mm_free(p.ptr);
+          else           free(p.ptr);
+          
+          registry().remove(p.owner, p.bytes);
          
           // remove element on top
           ptr_stack.pop();
@@ -387,15 +545,57 @@ class allocate
     **/
     template<class T> allocate&& operator()(T **g)
     {
-         
-         if(flags & alloc_flags::MA) *g = ((T *) _mm_malloc(Num * sizeof(T), 64));
-         else                        *g = ((T *)     malloc(Num * sizeof(T)));
+         const size_t bytes    = size_t(Num) * sizeof(T);
+         const size_t HugePage = 2 << 20;
+
+         // only large arrays benefit from huge pages, align to 2 MB boundary
+         const bool useHuge = (flags & alloc_flags::HUGE_PAGES) && (bytes >= HugePage);
 
-           ptr_stack.push((void *) *g);
+         if(useHuge) {
+           
+           void *ptr = nullptr;
+           if(posix_memalign(&ptr, HugePage, bytes) != 0) ptr = nullptr;
+           *g = (T *) ptr;
+#ifdef MADV_HUGEPAGE
+           // advise only, it is not an error if the kernel does not support THP
+           if((ptr != nullptr) && (madvise(ptr, bytes, MADV_HUGEPAGE) == 0)) registry().bytesHugePages += bytes;
+#endif
+         }
+         else if(flags & alloc_flags::MA) *g = ((T *) _mm_malloc(bytes, 64));
+         else                             *g = ((T *)     malloc(bytes));
+
+         if((*g == nullptr) && (Num > 0)) {
+           std::cerr << "nct::allocate : failed to allocate " << bytes << " bytes" << std::endl;
+           abort();
+         }
+
+         ptr_stack.push({ (void *) *g, !useHuge && (flags & alloc_flags::MA), bytes, registry().owner });
+         registry().add(registry().owner, name, bytes);
         
          // set to zero
          if(flags & SET_ZERO) {
-            for(int n=0; n < Num; n++) (*g)[n] = T(0);
+
+#ifdef _OPENMP
+           // first-touch, zero with the same static schedule as the kernels. Only 
+           // possible outside of parallel regions, otherwise fall back to serial 
+           if((flags & alloc_flags::FIRST_TOUCH) && !omp_in_parallel()) {
+
+             const int NumBlock = NumPar * NumInner;
+             T *p = *g;
+
+             for(int o = 0; o < NumOuter; o++) {
+               #pragma omp parallel for schedule(static)
+               for(int n = 0; n < NumPar; n++) {
+                 T *q = p + size_t(o) * NumBlock + size_t(n) * NumInner;
+                 for(int i = 0; i < NumInner; i++) q[i] = T(0);
+               }
+             }
+             
+             registry().bytesFirstTouch += bytes;
+           }
+           else 
+#endif
+           for(int n=0; n < Num; n++) (*g)[n] = T(0);
          }
 
          // Take care, pointer arithmetic is typed, only char* is 1 Byte !!!
@@ -46,7 +46,7 @@ int main(int argc, char **argv)
   int c;
   extern char *optarg;
 
-  while ((c = getopt(argc, argv, "x:o:c:d:v;s:;f;i")) != -1) {
+  while ((c = getopt(argc, argv, "x:o:c:d:v;s:;f;i;m")) != -1) {
 
     switch(c) {
 
@@ -66,6 +66,8 @@ int main(int argc, char **argv)
                        break;
       case 'i' : gkcFlags           |= Setup::GKC_READ_STDIN;
                        break;
+      case 'm' : gkcFlags           |= Setup::GKC_DRY_RUN;
+                       break;
       //case 'b' : gkcFlags         |= GKC_SILENT;
       //               break;
       default:
@@ -79,6 +81,14 @@ int main(int argc, char **argv)
   // Get simulation properties and setup
   Setup *setup    = new Setup(argc, argv, setup_filename, setup_decomposition, setup_Xoptions, setup_ExArgv, gkcFlags);
 
+  // Dry-run, only estimate memory footprint and exit 
+  if(gkcFlags & Setup::GKC_DRY_RUN) {
+    
+    GKC::estimateMemory(setup);
+    delete setup;
+    return 0;
+  }
+
   //////////////////    Start gkc engine and main loop /////////////////////
 
   // define static, as destructor is called @ exit() (see, § 3.6.3 of C++03) 